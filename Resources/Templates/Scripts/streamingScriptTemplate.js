@@ -25,4 +25,23 @@ function dataReceived(data)
 	{
 		script.log(" > " + data[i]);
 	}
-}
\ No newline at end of file
+}
+
+/*
+UDP Modules also call datagramReceived(data, senderIP, senderPort) for each received datagram, before it is split depending on the Protocol.
+data is always an array of bytes holding the whole datagram.
+*/
+
+function datagramReceived(data, senderIP, senderPort)
+{
+	script.log("Datagram of " + data.length + " bytes received from " + senderIP + ":" + senderPort);
+}
+
+/*
+TCP Server Modules keep a separate stream for each connected client, identified as "ip:port".
+The client that sent the last received data is available in the "Last Client" parameter.
+
+local.getClients(); //returns the ids of all connected clients
+local.sendTo("192.168.1.20:51234", "This is my message"); //sends only to this client
+local.sendBytesTo("192.168.1.20:51234", 30, 210, 46); //sends bytes only to this client
+*/
\ No newline at end of file
@@ -14,6 +14,9 @@
 #include "Common/Zeroconf/ZeroconfManager.h"
 #include "Common/InputSystem/InputSystemManager.h"
 #include "Common/DMX/DMXManager.h"
+#include "Common/Engine/EngineClock.h"
+#include "Common/Engine/EngineThread.h"
+#include "Common/OSCQuery/OSCQueryServer.h"
 
 #include "UI/ChataigneAssetManager.h"
 #include "CustomVariables/CVGroupManager.h"
@@ -54,6 +57,8 @@ ChataigneEngine::ChataigneEngine() :
 	ZeroconfManager::getInstance()->addSearcher("Workstation", "_workstation._tcp.");
 
 	getAppSettings()->addChildControllableContainer(&defaultBehaviors);
+	getAppSettings()->addChildControllableContainer(EngineClock::getInstance());
+	getAppSettings()->addChildControllableContainer(OSCQueryServer::getInstance());
 
 }
 
@@ -64,6 +69,11 @@ ChataigneEngine::~ChataigneEngine()
 
 	isClearing = true;
 
+	EngineThread::deleteInstance(); //stop processing input before anything gets deleted
+
+	getAppSettings()->removeChildControllableContainer(OSCQueryServer::getInstance());
+	OSCQueryServer::deleteInstance();
+
 	ZeroconfManager::deleteInstance();
 	CommunityModuleManager::deleteInstance();
 	ModuleRouterManager::deleteInstance();
@@ -84,6 +94,9 @@ ChataigneEngine::~ChataigneEngine()
 	CVGroupManager::deleteInstance();
 
 	Guider::deleteInstance();
+
+	getAppSettings()->removeChildControllableContainer(EngineClock::getInstance());
+	EngineClock::deleteInstance();
 }
 
 
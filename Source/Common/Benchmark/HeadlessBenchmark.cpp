@@ -0,0 +1,669 @@
+/*
+  ==============================================================================
+
+    HeadlessBenchmark.cpp
+    Created: 18 Oct 2026 4:12:08pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "HeadlessBenchmark.h"
+#include "Module/ModuleManager.h"
+#include "Module/modules/osc/custom/CustomOSCModule.h"
+#include "Module/modules/osc/transport/OSCPacketCodec.h"
+#include "Module/modules/common/streaming/StreamingModule.h"
+#include "Common/OSCQuery/OSCQueryServer.h"
+#include "Common/Serial/COBSFrameDecoder.h"
+#include "Common/WebSocket/WebSocketClient.h"
+
+namespace
+{
+	String getCommandString(const String &command, const String &data)
+	{
+		DynamicObject * o = new DynamicObject();
+		o->setProperty("COMMAND", command);
+		o->setProperty("DATA", data);
+		return JSON::toString(var(o), true);
+	}
+
+	double getElapsedMs(double startTime)
+	{
+		return Time::getMillisecondCounterHiRes() - startTime;
+	}
+
+	//counts the value updates streamed by the OSCQuery server and keeps the last one of each address
+	class OSCQueryBenchListener :
+		public WebSocketClient::Listener
+	{
+	public:
+		std::atomic<bool> isOpen { false };
+		std::atomic<int> numFrames { 0 };
+		std::atomic<int> numUpdates { 0 };
+
+		SpinLock valuesLock;
+		HashMap<String, float> lastValues;
+
+		void connectionOpened() override { isOpen = true; }
+
+		void dataReceived(const MemoryBlock &data) override
+		{
+			numFrames++;
+			try
+			{
+				addValues(OSCPacketCodec::readPacket(data.getData(), data.getSize()));
+			}
+			catch (OSCFormatError &)
+			{
+			}
+		}
+
+		void addValues(const OSCBundle::Element &e)
+		{
+			if (e.isBundle())
+			{
+				for (auto &child : e.getBundle()) addValues(child);
+				return;
+			}
+
+			const OSCMessage &m = e.getMessage();
+			numUpdates++;
+			if (m.isEmpty() || !m[0].isFloat32()) return;
+
+			GenericScopedLock<SpinLock> lock(valuesLock);
+			lastValues.set(m.getAddressPattern().toString(), m[0].getFloat32());
+		}
+	};
+
+	bool isListenedByAClient(OSCQueryServer * server, const String &address)
+	{
+		const ScopedLock lock(server->clients.getLock());
+		for (auto &c : server->clients) if (c->isWebSocket && c->isListening(address)) return true;
+		return false;
+	}
+
+	//a module that is not part of the show, with float values at /bench/value0, /bench/value1... The message thread must be locked
+	CustomOSCModule * createBenchOSCModule(int numValues)
+	{
+		CustomOSCModule * m = new CustomOSCModule();
+		m->receiveCC->enabled->setValue(false);
+		for (int i = 0; i < numValues; i++)
+		{
+			const String address = "/bench/value" + String(i);
+			Controllable * c = new FloatParameter(address, "", 0, 0, 1);
+			c->setCustomShortName(address.replaceCharacters("/", "_")); //as auto added values
+			m->valuesCC.addControllable(c);
+		}
+		return m;
+	}
+
+	//reference COBS encoder, the frame and its 0 delimiter are appended to output
+	void appendCOBSFrame(const uint8 * data, size_t size, std::vector<uint8> &output)
+	{
+		size_t codeIndex = output.size();
+		output.push_back(1);
+		for (size_t i = 0; i < size; i++)
+		{
+			if (data[i] != 0)
+			{
+				output.push_back(data[i]);
+				if (++output[codeIndex] != 0xFF) continue;
+				if (i == size - 1) break;
+			}
+
+			codeIndex = output.size();
+			output.push_back(1);
+		}
+
+		output.push_back(0);
+	}
+}
+
+HeadlessBenchmark::HeadlessBenchmark(const StringArray & names, const StringPairArray & options, std::function<void(bool success)> onFinished) :
+	Thread("Benchmark"),
+	names(names),
+	options(options),
+	onFinished(onFinished)
+{
+}
+
+HeadlessBenchmark::~HeadlessBenchmark()
+{
+	stopThread(10000);
+}
+
+StringArray HeadlessBenchmark::getBenchmarkNames()
+{
+	return StringArray("oscquery", "customosc-lookup", "customosc-pattern", "streaming-lines", "cobs");
+}
+
+void HeadlessBenchmark::run()
+{
+	bool success = true;
+	for (auto &n : names)
+	{
+		if (threadShouldExit()) break;
+
+		if (!getBenchmarkNames().contains(n))
+		{
+			LOGERROR("Unknown benchmark " << n << ", available benchmarks : " << getBenchmarkNames().joinIntoString(", "));
+			success = false;
+			continue;
+		}
+
+		LOG("Running benchmark " << n);
+		if (!runBenchmark(n)) success = false;
+	}
+
+	if (onFinished != nullptr) onFinished(success);
+}
+
+bool HeadlessBenchmark::runBenchmark(const String & name)
+{
+	if (name == "oscquery") return runOSCQueryLoad();
+	if (name == "customosc-lookup") return runCustomOSCLookup();
+	if (name == "customosc-pattern") return runCustomOSCPattern();
+	if (name == "streaming-lines") return runStreamingLines();
+	if (name == "cobs") return runCOBSDecode();
+	return false;
+}
+
+int HeadlessBenchmark::getIntOption(const String & name, int defaultValue) const
+{
+	return options.containsKey(name) ? options[name].getIntValue() : defaultValue;
+}
+
+String HeadlessBenchmark::formatRate(double count, double ms)
+{
+	return String(count * 1000.0 / jmax(ms, 0.001), 0) + "/s";
+}
+
+String HeadlessBenchmark::formatTimePerItem(double ms, double count)
+{
+	return String(ms * 1000000.0 / jmax(count, 1.0), 1) + " ns";
+}
+
+bool HeadlessBenchmark::runOSCQueryLoad()
+{
+	//Loopback load test of the OSCQuery server : a module with thousands of values is exposed, a WebSocket client fetches the namespace
+	//and listens to every value while they all change, then the values are set back with OSC over UDP.
+	//Options : nodes (5000), port (42999), duration of the value changes in ms (2000)
+	const int numNodes = jmax(getIntOption("nodes", 5000), 1);
+	const int port = getIntOption("port", 42999);
+	const int durationMs = getIntOption("duration", 2000);
+
+	OSCQueryServer * server = nullptr;
+	CustomOSCModule * module = nullptr;
+	Array<Parameter *> values;
+	StringArray addresses;
+	bool serverWasEnabled = false;
+	int serverPort = 0;
+
+	{
+		const MessageManagerLock mmLock(this);
+		if (!mmLock.lockWasGained()) return false;
+
+		module = new CustomOSCModule();
+		module->receiveCC->enabled->setValue(false); //only exposed, its own input is not needed
+		ModuleManager::getInstance()->addItem(module, var(), false);
+		module->setNiceName("OSCQuery Bench");
+
+		for (int i = 0; i < numNodes; i++)
+		{
+			Parameter * p = module->valuesCC.addFloatParameter("/bench/value" + String(i), "", 0, 0, 1);
+			values.add(p);
+			addresses.add(p->getControlAddress());
+		}
+
+		server = OSCQueryServer::getInstance();
+		serverWasEnabled = server->enableServer->boolValue();
+		serverPort = server->port->intValue();
+		server->port->setValue(port);
+		server->enableServer->setValue(true);
+	}
+
+	auto runTest = [&]() -> bool
+	{
+		//NAMESPACE
+		double startTime = Time::getMillisecondCounterHiRes();
+		std::unique_ptr<InputStream> stream(URL("http://127.0.0.1:" + String(port) + "/").createInputStream(false, nullptr, nullptr, String(), 10000));
+		String json = stream != nullptr ? stream->readEntireStreamAsString() : String();
+		double namespaceMs = getElapsedMs(startTime);
+
+		if (!JSON::parse(json).isObject())
+		{
+			LOGERROR("OSCQuery load : could not get the namespace on port " << port);
+			return false;
+		}
+
+		LOG("OSCQuery load : namespace of " << numNodes << " values, " << (int)(json.getNumBytesAsUTF8() / 1024) << " kB in " << String(namespaceMs, 1) << " ms");
+
+		//LISTEN
+		OSCQueryBenchListener listener;
+		WebSocketClient ws("OSCQuery Bench");
+		ws.addWebSocketListener(&listener);
+		ws.start("127.0.0.1", port);
+
+		for (int i = 0; i < 500 && !listener.isOpen && !threadShouldExit(); i++) wait(10);
+		if (!listener.isOpen)
+		{
+			LOGERROR("OSCQuery load : could not open the WebSocket on port " << port);
+			ws.stop();
+			return false;
+		}
+
+		startTime = Time::getMillisecondCounterHiRes();
+		for (auto &a : addresses) ws.send(getCommandString("LISTEN", a));
+
+		//the commands are handled in order, once the last one is listened they all are
+		while (!isListenedByAClient(server, addresses[numNodes - 1]) && getElapsedMs(startTime) < 10000 && !threadShouldExit()) wait(1);
+		LOG("OSCQuery load : " << numNodes << " LISTEN commands handled in " << String(getElapsedMs(startTime), 1) << " ms");
+
+		//VALUE CHANGES : every value changes every 10ms, the server conflates them to Max Update Rate
+		int numRounds = 0;
+		float lastValue = 0;
+		double setValueMs = 0;
+		startTime = Time::getMillisecondCounterHiRes();
+		while (getElapsedMs(startTime) < durationMs && !threadShouldExit())
+		{
+			{
+				const MessageManagerLock mmLock(this);
+				if (!mmLock.lockWasGained()) break;
+
+				lastValue = ((numRounds % 100) + 1) / 101.0f;
+				double setStartTime = Time::getMillisecondCounterHiRes();
+				for (auto &p : values) p->setValue(lastValue);
+				setValueMs += getElapsedMs(setStartTime);
+			}
+
+			numRounds++;
+			wait(10);
+		}
+
+		double changesMs = getElapsedMs(startTime);
+		wait(500); //last flush
+
+		int numFinalValues = 0;
+		{
+			GenericScopedLock<SpinLock> lock(listener.valuesLock);
+			for (auto &a : addresses) if (listener.lastValues.contains(a) && listener.lastValues[a] == lastValue) numFinalValues++;
+		}
+
+		ws.stop();
+		ws.removeWebSocketListener(&listener);
+
+		double numChanges = (double)numRounds * numNodes;
+		LOG("OSCQuery load : " << (int64)numChanges << " value changes in " << String(changesMs, 0) << " ms (" << formatRate(numChanges, changesMs) << "), "
+			<< String(setValueMs * 1000.0 / jmax(numChanges, 1.0), 2) << " us per setValue with a listening client");
+		LOG("OSCQuery load : received " << listener.numUpdates.load() << " updates in " << listener.numFrames.load() << " frames (" << formatRate(listener.numUpdates.load(), changesMs) << "), "
+			<< numFinalValues << " of " << numNodes << " final values received");
+
+		if (numFinalValues != numNodes)
+		{
+			LOGERROR("OSCQuery load : the last value of " << (numNodes - numFinalValues) << " addresses was not received");
+			return false;
+		}
+
+		//SET OVER UDP : applied on the message thread
+		OSCSender sender;
+		sender.connect("127.0.0.1", port);
+
+		startTime = Time::getMillisecondCounterHiRes();
+		for (int i = 0; i < numNodes; i += 64)
+		{
+			OSCBundle b;
+			for (int j = i; j < jmin(i + 64, numNodes); j++)
+			{
+				OSCMessage m(addresses[j]);
+				m.addFloat32(1.0f);
+				b.addElement(m);
+			}
+			sender.send(b);
+		}
+
+		int numApplied = 0;
+		while (getElapsedMs(startTime) < 10000 && !threadShouldExit())
+		{
+			{
+				const MessageManagerLock mmLock(this);
+				if (!mmLock.lockWasGained()) break;
+
+				numApplied = 0;
+				for (auto &p : values) if (p->floatValue() == 1.0f) numApplied++;
+			}
+
+			if (numApplied == numNodes) break;
+			wait(5);
+		}
+
+		double udpMs = getElapsedMs(startTime);
+		LOG("OSCQuery load : " << numApplied << " of " << numNodes << " values set over UDP in " << String(udpMs, 1) << " ms (" << formatRate(numApplied, udpMs) << ")");
+		if (numApplied != numNodes) LOGWARNING("OSCQuery load : " << (numNodes - numApplied) << " values were not set, UDP packets may have been dropped");
+
+		return true;
+	};
+
+	bool result = runTest();
+
+	const MessageManagerLock mmLock(this);
+	if (mmLock.lockWasGained())
+	{
+		server->port->setValue(serverPort);
+		server->enableServer->setValue(serverWasEnabled);
+		ModuleManager::getInstance()->removeItem(module, false);
+	}
+
+	return result;
+}
+
+bool HeadlessBenchmark::runCustomOSCLookup()
+{
+	//Address lookup of CustomOSCModule values with the address index, compared to the short name search of the container it replaced.
+	//Options : lookups per size (1000000)
+	const int numLookups = jmax(getIntOption("lookups", 1000000), 1);
+	const int sizes[] = { 10, 1000, 10000 };
+
+	for (int numValues : sizes)
+	{
+		std::unique_ptr<CustomOSCModule> module;
+		double createMs = 0;
+		{
+			const MessageManagerLock mmLock(this);
+			if (!mmLock.lockWasGained()) return false;
+
+			double startTime = Time::getMillisecondCounterHiRes();
+			module.reset(createBenchOSCModule(numValues));
+			createMs = getElapsedMs(startTime);
+		}
+
+		StringArray addresses;
+		for (int i = 0; i < numValues; i++) addresses.add("/bench/value" + String(i));
+
+		int numFound = 0;
+		double startTime = Time::getMillisecondCounterHiRes();
+		for (int i = 0; i < numLookups; i++) if (module->getValueForAddress(addresses[i % numValues]) != nullptr) numFound++;
+		double indexMs = getElapsedMs(startTime);
+
+		//the container search is much slower on big modules, it is run fewer times
+		const int numLinearLookups = jlimit(1, numLookups, 10000000 / numValues);
+		int numLinearFound = 0;
+		startTime = Time::getMillisecondCounterHiRes();
+		for (int i = 0; i < numLinearLookups; i++)
+		{
+			if (module->valuesCC.getControllableByName(addresses[i % numValues].replaceCharacters("/", "_")) != nullptr) numLinearFound++;
+		}
+		double linearMs = getElapsedMs(startTime);
+
+		LOG("CustomOSC lookup : " << numValues << " values created and indexed in " << String(createMs, 1) << " ms, index " << formatTimePerItem(indexMs, numLookups)
+			<< " per lookup (" << formatRate(numLookups, indexMs) << "), container search " << formatTimePerItem(linearMs, numLinearLookups) << " per lookup (" << formatRate(numLinearLookups, linearMs) << ")");
+
+		{
+			const MessageManagerLock mmLock(this);
+			if (!mmLock.lockWasGained()) return false;
+			module.reset();
+		}
+
+		if (numFound != numLookups || numLinearFound != numLinearLookups)
+		{
+			LOGERROR("CustomOSC lookup : " << (numLookups - numFound) << " addresses were not found in the index of " << numValues << " values");
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool HeadlessBenchmark::runCustomOSCPattern()
+{
+	//Incoming messages addressed to a CustomOSCModule value, compared to address patterns matching 10 values each,
+	//with the pattern cache and with the cache cleared before each message, as for a pattern seen for the first time.
+	//Options : values (1000), messages (100000)
+	const int numValues = jmax(getIntOption("values", 1000), 1000); //the patterns address values 100 to 999
+	const int numMessages = jmax(getIntOption("messages", 100000), 1);
+
+	Array<OSCReceivedMessage> exactMessages;
+	Array<OSCReceivedMessage> patternMessages;
+	for (int i = 0; i < 1000; i++)
+	{
+		const float v = (i % 97) / 97.0f;
+
+		OSCMessage m("/bench/value" + String(i % numValues));
+		m.addFloat32(v);
+		exactMessages.add(OSCReceivedMessage(m));
+
+		OSCMessage pm("/bench/value" + String(1 + i % 9) + String(i % 10) + "?"); //e.g. /bench/value12? matches /bench/value120 to /bench/value129
+		pm.addFloat32(v);
+		patternMessages.add(OSCReceivedMessage(pm));
+	}
+
+	const MessageManagerLock mmLock(this);
+	if (!mmLock.lockWasGained()) return false;
+
+	std::unique_ptr<CustomOSCModule> module(createBenchOSCModule(numValues));
+	module->autoAdd->setValue(false);
+
+	double startTime = Time::getMillisecondCounterHiRes();
+	for (int i = 0; i < numMessages; i++) module->processMessageInternal(exactMessages.getReference(i % exactMessages.size()));
+	double exactMs = getElapsedMs(startTime);
+
+	startTime = Time::getMillisecondCounterHiRes();
+	for (int i = 0; i < numMessages; i++) module->processMessageInternal(patternMessages.getReference(i % patternMessages.size()));
+	double cachedMs = getElapsedMs(startTime);
+
+	//clearing the cache is what adding, removing or renaming a value does
+	const int numUncachedMessages = jmax(numMessages / 10, 1);
+	startTime = Time::getMillisecondCounterHiRes();
+	for (int i = 0; i < numUncachedMessages; i++)
+	{
+		{
+			const SpinLock::ScopedLockType sl(module->addressIndexLock);
+			module->patternIndex.clear();
+			module->patternEntries.clear();
+		}
+
+		module->processMessageInternal(patternMessages.getReference(i % patternMessages.size()));
+	}
+	double uncachedMs = getElapsedMs(startTime);
+
+	Array<CustomOSCModule::PatternTarget> targets;
+	module->getValuesForPattern(patternMessages.getReference(0).message.getAddressPattern().toString(), targets);
+
+	LOG("CustomOSC pattern : " << numValues << " values, exact address " << formatTimePerItem(exactMs, numMessages) << " per message (" << formatRate(numMessages, exactMs) << ")");
+	LOG("CustomOSC pattern : pattern matching " << targets.size() << " values " << formatTimePerItem(cachedMs, numMessages) << " per message (" << formatRate(numMessages, cachedMs) << ") with the cache, "
+		<< formatTimePerItem(uncachedMs, numUncachedMessages) << " per message (" << formatRate(numUncachedMessages, uncachedMs) << ") without");
+
+	module.reset();
+
+	if (targets.size() != 10)
+	{
+		LOGERROR("CustomOSC pattern : " << patternMessages.getReference(0).message.getAddressPattern().toString() << " matched " << targets.size() << " values instead of 10");
+		return false;
+	}
+
+	return true;
+}
+
+bool HeadlessBenchmark::runStreamingLines()
+{
+	//"name value value" lines parsed by a streaming module with existing 2D values, as fast as possible then paced at fixed rates.
+	//Lines are parsed on the benchmark thread, as they are on the receiving thread of serial and network modules.
+	//Options : values (100), lines for the unpaced run (200000), duration of each paced run in ms (1000)
+	const int numValues = jmax(getIntOption("values", 100), 1);
+	const int numLines = jmax(getIntOption("lines", 200000), 1);
+	const int durationMs = jmax(getIntOption("duration", 1000), 10);
+	const int rates[] = { 1000, 10000, 100000, 1000000 };
+
+	StringArray lines;
+	for (int i = 0; i < 1000; i++) lines.add("value" + String(i % numValues) + " " + String((i % 97) / 97.0f, 4) + " " + String((i % 89) / 89.0f, 4));
+
+	std::unique_ptr<StreamingModule> module;
+	{
+		const MessageManagerLock mmLock(this);
+		if (!mmLock.lockWasGained()) return false;
+
+		module.reset(new StreamingModule("Streaming Bench"));
+		module->autoAdd->setValue(false);
+		module->messageStructure->setValueWithData(StreamingModule::LINES_SPACE);
+		module->firstValueIsTheName->setValue(true);
+		for (int i = 0; i < numValues; i++) module->valuesCC.addPoint2DParameter("value" + String(i), "");
+	}
+
+	//UNPACED
+	double startTime = Time::getMillisecondCounterHiRes();
+	for (int i = 0; i < numLines; i++) module->processDataLine(lines[i % lines.size()]);
+	double maxMs = getElapsedMs(startTime);
+
+	LOG("Streaming lines : " << numValues << " values, " << numLines << " lines in " << String(maxMs, 1) << " ms, " << formatTimePerItem(maxMs, numLines) << " per line (" << formatRate(numLines, maxMs) << ")");
+
+	const String lastLine = lines[(numLines - 1) % lines.size()];
+	Parameter * lastTarget = dynamic_cast<Parameter *>(module->valuesCC.getControllableByName(lastLine.upToFirstOccurrenceOf(" ", false, false)));
+	bool lastLineApplied = lastTarget != nullptr && std::abs((float)lastTarget->getValue()[0] - lastLine.fromFirstOccurrenceOf(" ", false, false).getFloatValue()) < 0.0001f;
+	bool fastPathUsed = module->valueIndexEntries.size() > 0 && !module->lastLookupMissed;
+
+	//PACED : the lines due since the start are parsed every millisecond, the load is the time spent parsing them
+	for (int rate : rates)
+	{
+		if (threadShouldExit()) break;
+
+		int64 numSent = 0;
+		double busyMs = 0;
+		startTime = Time::getMillisecondCounterHiRes();
+		double elapsedMs = 0;
+		while ((elapsedMs = getElapsedMs(startTime)) < durationMs && !threadShouldExit())
+		{
+			const int64 numDue = (int64)(rate * elapsedMs / 1000.0);
+			double parseStartTime = Time::getMillisecondCounterHiRes();
+			for (; numSent < numDue; numSent++) module->processDataLine(lines[(int)(numSent % lines.size())]);
+			busyMs += getElapsedMs(parseStartTime);
+
+			wait(1);
+		}
+
+		elapsedMs = getElapsedMs(startTime);
+		LOG("Streaming lines : " << rate << " lines/s asked, " << formatRate((double)numSent, elapsedMs) << " parsed, " << String(busyMs * 100.0 / jmax(elapsedMs, 0.001), 1) << "% of a thread");
+	}
+
+	{
+		const MessageManagerLock mmLock(this);
+		if (mmLock.lockWasGained()) module.reset();
+	}
+
+	if (!lastLineApplied)
+	{
+		LOGERROR("Streaming lines : the value of the last line \"" << lastLine << "\" was not applied");
+		return false;
+	}
+
+	if (!fastPathUsed) LOGWARNING("Streaming lines : the lines were not parsed by the fast path");
+
+	return true;
+}
+
+bool HeadlessBenchmark::runCOBSDecode()
+{
+	//COBS stream decoding as serial and network modules do it, fed in chunks like the ones read from a port.
+	//Frames of several sizes are decoded as fast as possible, then frames of the chosen size are paced at 1 to 4 MB/s.
+	//Options : frame size for the paced runs (64), chunk size (256), MB decoded per unpaced run (64), duration of each paced run in ms (1000)
+	const int frameSize = jmax(getIntOption("frame", 64), 1);
+	const int chunkSize = jmax(getIntOption("chunk", 256), 1);
+	const int numMegabytes = jmax(getIntOption("mb", 64), 1);
+	const int durationMs = jmax(getIntOption("duration", 1000), 10);
+	const int sizes[] = { 16, 254, 4096, 65536 };
+	const size_t megabyte = 1024 * 1024;
+
+	Random random(0x0C0B5);
+	auto createStream = [&random](int size, std::vector<uint8> &frames, std::vector<uint8> &stream)
+	{
+		//about 1MB of frames, with 0s to stuff and runs longer than a COBS block
+		const int numFrames = jmax((int)(megabyte / size), 1);
+		frames.resize((size_t)numFrames * size);
+		for (auto &b : frames) b = random.nextInt(8) == 0 ? 0 : (uint8)random.nextInt(256);
+		for (size_t i = 0; i + 600 < frames.size(); i += 4096) memset(frames.data() + i, 0x55, 600);
+
+		stream.clear();
+		for (int i = 0; i < numFrames; i++) appendCOBSFrame(frames.data() + (size_t)i * size, size, stream);
+	};
+
+	auto feed = [chunkSize](COBSFrameDecoder &decoder, const std::vector<uint8> &stream, size_t &numDecodedBytes)
+	{
+		for (size_t i = 0; i < stream.size(); i += chunkSize)
+		{
+			decoder.process(stream.data() + i, jmin((size_t)chunkSize, stream.size() - i), [&numDecodedBytes](const uint8 *, size_t size) { numDecodedBytes += size; });
+		}
+	};
+
+	std::vector<uint8> frames;
+	std::vector<uint8> stream;
+
+	//UNPACED
+	for (int size : sizes)
+	{
+		if (threadShouldExit()) break;
+
+		createStream(size, frames, stream);
+
+		COBSFrameDecoder decoder;
+		int numChecked = 0;
+		decoder.process(stream.data(), stream.size(), [&](const uint8 * data, size_t decodedSize)
+		{
+			if (decodedSize == (size_t)size && memcmp(data, frames.data() + (size_t)numChecked * size, decodedSize) == 0) numChecked++;
+		});
+
+		const int numFrames = (int)(frames.size() / size);
+		if (numChecked != numFrames || decoder.numInvalidFrames != 0)
+		{
+			LOGERROR("COBS : " << (numFrames - numChecked) << " of " << numFrames << " frames of " << size << " bytes were not decoded back to their data");
+			return false;
+		}
+
+		const int numRuns = jmax((int)(numMegabytes * megabyte / stream.size()), 1);
+		size_t numDecodedBytes = 0;
+		double startTime = Time::getMillisecondCounterHiRes();
+		for (int i = 0; i < numRuns; i++) feed(decoder, stream, numDecodedBytes);
+		double decodeMs = getElapsedMs(startTime);
+
+		LOG("COBS : frames of " << size << " bytes in chunks of " << chunkSize << ", " << String(numDecodedBytes * 1000.0 / megabyte / jmax(decodeMs, 0.001), 1) << " MB/s decoded ("
+			<< formatRate((double)numRuns * numFrames, decodeMs) << " frames)");
+	}
+
+	//PACED : the chunks due since the start are decoded every millisecond, the load is the time spent decoding them
+	createStream(frameSize, frames, stream);
+	COBSFrameDecoder decoder;
+
+	for (int rate = 1; rate <= 4 && !threadShouldExit(); rate++)
+	{
+		const double bytesPerMs = rate * megabyte / 1000.0;
+		size_t numSent = 0;
+		size_t numDecodedBytes = 0;
+		double busyMs = 0;
+		double startTime = Time::getMillisecondCounterHiRes();
+		double elapsedMs = 0;
+		while ((elapsedMs = getElapsedMs(startTime)) < durationMs && !threadShouldExit())
+		{
+			const size_t numDue = (size_t)(bytesPerMs * elapsedMs);
+			double decodeStartTime = Time::getMillisecondCounterHiRes();
+			while (numSent + chunkSize <= numDue)
+			{
+				const size_t offset = numSent % stream.size();
+				const size_t size = jmin((size_t)chunkSize, stream.size() - offset);
+				decoder.process(stream.data() + offset, size, [&numDecodedBytes](const uint8 *, size_t decodedSize) { numDecodedBytes += decodedSize; });
+				numSent += size;
+			}
+			busyMs += getElapsedMs(decodeStartTime);
+
+			wait(1);
+		}
+
+		elapsedMs = getElapsedMs(startTime);
+		LOG("COBS : " << rate << " MB/s of frames of " << frameSize << " bytes, " << String(numSent * 1000.0 / megabyte / jmax(elapsedMs, 0.001), 2) << " MB/s received, "
+			<< String(numDecodedBytes * 1000.0 / megabyte / jmax(elapsedMs, 0.001), 2) << " MB/s decoded, " << String(busyMs * 100.0 / jmax(elapsedMs, 0.001), 2) << "% of a thread");
+	}
+
+	if (decoder.numInvalidFrames != 0)
+	{
+		LOGERROR("COBS : " << decoder.numInvalidFrames << " invalid frames in the paced runs");
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,48 @@
+/*
+  ==============================================================================
+
+    HeadlessBenchmark.h
+    Created: 18 Oct 2026 4:12:08pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "JuceHeader.h"
+
+/*
+	Benchmarks run from the command line, without a show : Chataigne --headless --bench=name[,name..] [--bench-option=value..]
+	Benchmarks run one after the other on their own thread and log their results. They lock the message thread when they touch the object tree,
+	and leave it free while they wait for work it has to do, like applying the values received by the OSCQuery server.
+*/
+class HeadlessBenchmark :
+	public Thread
+{
+public:
+	HeadlessBenchmark(const StringArray &names, const StringPairArray &options, std::function<void(bool success)> onFinished);
+	~HeadlessBenchmark();
+
+	StringArray names;
+	StringPairArray options; //--bench-nodes=5000 is given as nodes=5000
+	std::function<void(bool success)> onFinished;
+
+	static StringArray getBenchmarkNames();
+
+	void run() override;
+
+private:
+	bool runBenchmark(const String &name);
+	int getIntOption(const String &name, int defaultValue) const;
+	static String formatRate(double count, double ms);
+	static String formatTimePerItem(double ms, double count);
+
+	bool runOSCQueryLoad();
+	bool runCustomOSCLookup();
+	bool runCustomOSCPattern();
+	bool runStreamingLines();
+	bool runCOBSDecode();
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(HeadlessBenchmark)
+};
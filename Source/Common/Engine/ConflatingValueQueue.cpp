@@ -0,0 +1,81 @@
+/*
+  ==============================================================================
+
+    ConflatingValueQueue.cpp
+    Created: 17 Oct 2026 5:02:37pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "ConflatingValueQueue.h"
+
+ConflatingValueQueue::ConflatingValueQueue() :
+	numApplied(0),
+	numConflated(0)
+{
+}
+
+ConflatingValueQueue::~ConflatingValueQueue()
+{
+}
+
+void ConflatingValueQueue::push(Controllable* c, const var& value)
+{
+	if (c == nullptr) return;
+
+	const SpinLock::ScopedLockType sl(lock);
+
+	if (c->type != Controllable::TRIGGER)
+	{
+		if (pendingIndex.contains(c))
+		{
+			pending.getReference(pendingIndex[c]).value = value;
+			numConflated++;
+			return;
+		}
+
+		pendingIndex.set(c, pending.size());
+	}
+
+	pending.add({ c, value });
+}
+
+int ConflatingValueQueue::flush()
+{
+	{
+		const SpinLock::ScopedLockType sl(lock);
+		processing.swapWith(pending);
+		pendingIndex.clear();
+	}
+
+	int numProcessed = processing.size();
+	for (auto& u : processing)
+	{
+		if (Controllable* c = u.target.get()) applyValue(c, u.value);
+	}
+
+	numApplied += numProcessed;
+	processing.clearQuick();
+
+	return numProcessed;
+}
+
+void ConflatingValueQueue::clear()
+{
+	const SpinLock::ScopedLockType sl(lock);
+	pending.clear();
+	pendingIndex.clear();
+}
+
+bool ConflatingValueQueue::isEmpty()
+{
+	const SpinLock::ScopedLockType sl(lock);
+	return pending.isEmpty();
+}
+
+void ConflatingValueQueue::applyValue(Controllable* c, const var& value)
+{
+	if (c->type == Controllable::TRIGGER) ((Trigger*)c)->trigger();
+	else ((Parameter*)c)->setValue(value);
+}
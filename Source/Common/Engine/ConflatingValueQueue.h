@@ -0,0 +1,51 @@
+/*
+  ==============================================================================
+
+    ConflatingValueQueue.h
+    Created: 17 Oct 2026 5:02:37pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "JuceHeader.h"
+#include <atomic>
+
+/*
+	Hands values over from an I/O thread to the processing side, keeping only the latest value of each target.
+	If a parameter is updated several times before the queue is flushed, only the newest value is applied.
+	Triggers are never merged, each one is kept and applied in order.
+*/
+class ConflatingValueQueue
+{
+public:
+	ConflatingValueQueue();
+	~ConflatingValueQueue();
+
+	std::atomic<int> numApplied;
+	std::atomic<int> numConflated;
+
+	void push(Controllable* c, const var& value);
+	int flush();
+	void clear();
+
+	bool isEmpty();
+
+	static void applyValue(Controllable* c, const var& value);
+
+private:
+	struct PendingUpdate
+	{
+		WeakReference<Controllable> target;
+		var value;
+	};
+
+	SpinLock lock;
+	Array<PendingUpdate> pending;
+	Array<PendingUpdate> processing;
+	HashMap<Controllable*, int> pendingIndex;
+
+	JUCE_DECLARE_NON_COPYABLE(ConflatingValueQueue)
+};
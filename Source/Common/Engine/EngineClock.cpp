@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+    EngineClock.cpp
+    Created: 17 Oct 2026 10:12:04am
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "EngineClock.h"
+#include "EngineThread.h"
+
+juce_ImplementSingleton(EngineClock)
+
+EngineClock::EngineClock() :
+	ControllableContainer("Engine Clock"),
+	lastTickTime(0)
+{
+	tickRate = addIntParameter("Tick Rate", "Rate of the engine clock, in Hz. Lag filters, condition validation times and generator modules are evaluated at this rate, continuous mappings at their own rate up to this one", 50, 30, 1000);
+	continuousMappingRate = addIntParameter("Continuous Mapping Rate", "Rate at which continuous mappings are processed, in Hz. They can't be processed faster than the tick rate", 30, 1, 1000);
+	useEngineThread = addBoolParameter("Use Engine Thread", "If checked, incoming data from the modules and the engine clock are processed on a dedicated high priority thread, so the output timing doesn't depend on what the interface is doing", false);
+}
+
+EngineClock::~EngineClock()
+{
+	stopTimer();
+}
+
+void EngineClock::addClockListener(ClockListener* newListener)
+{
+	clockListeners.add(newListener);
+	updateTimer();
+}
+
+void EngineClock::removeClockListener(ClockListener* listener)
+{
+	clockListeners.remove(listener);
+	if (clockListeners.isEmpty()) stopTimer();
+}
+
+void EngineClock::updateTimer()
+{
+	bool threaded = EngineThread::getInstanceWithoutCreating() != nullptr && EngineThread::getInstance()->isThreadRunning();
+	if (threaded || clockListeners.isEmpty())
+	{
+		stopTimer();
+		return;
+	}
+
+	if (!isTimerRunning())
+	{
+		lastTickTime = Time::getMillisecondCounterHiRes();
+		startTimerHz(tickRate->intValue());
+	}
+}
+
+void EngineClock::tick()
+{
+	double curTime = Time::getMillisecondCounterHiRes();
+	double deltaTime = (curTime - lastTickTime) / 1000.0;
+	lastTickTime = curTime;
+
+	clockListeners.call(&ClockListener::engineTick, deltaTime);
+}
+
+void EngineClock::onContainerParameterChanged(Parameter * p)
+{
+	if (p == tickRate)
+	{
+		if (isTimerRunning()) startTimerHz(tickRate->intValue());
+	}
+	else if (p == useEngineThread)
+	{
+		lastTickTime = Time::getMillisecondCounterHiRes();
+		if (useEngineThread->boolValue()) EngineThread::getInstance()->start();
+		else if (EngineThread::getInstanceWithoutCreating() != nullptr) EngineThread::getInstance()->stop();
+		updateTimer();
+	}
+}
+
+void EngineClock::timerCallback()
+{
+	tick();
+}
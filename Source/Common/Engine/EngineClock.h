@@ -0,0 +1,50 @@
+/*
+  ==============================================================================
+
+    EngineClock.h
+    Created: 17 Oct 2026 10:12:04am
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "JuceHeader.h"
+
+class EngineClock :
+	public ControllableContainer,
+	public Timer
+{
+public:
+	juce_DeclareSingleton(EngineClock, true);
+
+	EngineClock();
+	~EngineClock();
+
+	IntParameter * tickRate;
+	IntParameter * continuousMappingRate;
+	BoolParameter * useEngineThread;
+
+	double lastTickTime;
+
+	class ClockListener
+	{
+	public:
+		virtual ~ClockListener() {}
+		virtual void engineTick(double deltaTime) = 0; //deltaTime in seconds since last tick
+	};
+
+	ListenerList<ClockListener, Array<ClockListener*, CriticalSection>> clockListeners;
+	void addClockListener(ClockListener* newListener);
+	void removeClockListener(ClockListener* listener);
+
+	void updateTimer();
+	void tick();
+
+	void onContainerParameterChanged(Parameter * p) override;
+
+	void timerCallback() override;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EngineClock)
+};
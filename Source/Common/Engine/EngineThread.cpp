@@ -0,0 +1,152 @@
+/*
+  ==============================================================================
+
+    EngineThread.cpp
+    Created: 17 Oct 2026 2:40:02pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "EngineThread.h"
+#include "EngineClock.h"
+
+juce_ImplementSingleton(EngineThread)
+
+EngineInputQueue::EngineInputQueue(const String& name, int capacity) :
+	name(name),
+	queue(capacity),
+	isOpen(true),
+	numDropped(0)
+{
+}
+
+EngineInputQueue::~EngineInputQueue()
+{
+}
+
+bool EngineInputQueue::push(InputFunction inputFunc)
+{
+	if (!isOpen) return false;
+	
+	if (!queue.push(inputFunc))
+	{
+		numDropped++;
+		return false;
+	}
+
+	return true;
+}
+
+
+EngineThread::EngineThread() :
+	Thread("Engine"),
+	queuesChanged(false)
+{
+}
+
+EngineThread::~EngineThread()
+{
+	stop();
+}
+
+EngineInputQueue::Ptr EngineThread::createInputQueue(const String& name)
+{
+	EngineInputQueue::Ptr q = new EngineInputQueue(name);
+	queues.add(q);
+	queuesChanged = true;
+	return q;
+}
+
+void EngineThread::closeInputQueue(EngineInputQueue* q)
+{
+	if (q == nullptr) return;
+
+	const ScopedLock sl(processLock);
+	q->isOpen = false;
+	queues.removeObject(q);
+	queuesChanged = true;
+}
+
+bool EngineThread::postInput(EngineInputQueue* q, EngineInputQueue::InputFunction inputFunc)
+{
+	if (q == nullptr || !q->push(inputFunc)) return false;
+	notify();
+	return true;
+}
+
+void EngineThread::start()
+{
+	if (isThreadRunning() && !threadShouldExit()) return;
+
+	if (!waitForThreadToExit(1000)) //a previous stop timed out
+	{
+		LOGWARNING("Engine thread is still stopping, it can't be restarted yet");
+		return;
+	}
+
+	startThread(9);
+}
+
+void EngineThread::stop()
+{
+	if (!isThreadRunning()) return;
+	signalThreadShouldExit();
+	notify();
+	if (!waitForThreadToExit(1000))
+	{
+		//still inside a slow input or tick, flushing from here would pop the same queues concurrently. It flushes them itself when it exits
+		LOGWARNING("Engine thread is taking long to stop, its queues will be flushed when it exits");
+		return;
+	}
+
+	processQueues(INT32_MAX); //flush what may have been pushed while stopping
+}
+
+void EngineThread::processQueues(int maxPerQueue)
+{
+	if (queuesChanged.exchange(false))
+	{
+		const ScopedLock sl(queues.getLock());
+		queuesToProcess.clearQuick();
+		queuesToProcess.addArray(queues);
+	}
+
+	for (auto& q : queuesToProcess)
+	{
+		EngineInputQueue::InputFunction f;
+		int numProcessed = 0;
+		while (numProcessed < maxPerQueue && q->queue.pop(f))
+		{
+			const ScopedLock sl(processLock);
+			if (q->isOpen) f();
+			numProcessed++;
+		}
+	}
+}
+
+void EngineThread::run()
+{
+	double nextTickTime = Time::getMillisecondCounterHiRes();
+
+	while (!threadShouldExit())
+	{
+		processQueues();
+
+		double curTime = Time::getMillisecondCounterHiRes();
+		if (curTime >= nextTickTime)
+		{
+			EngineClock::getInstance()->tick();
+
+			double period = 1000.0 / EngineClock::getInstance()->tickRate->intValue();
+			nextTickTime += period;
+			if (nextTickTime < curTime) nextTickTime = curTime + period; //don't try to catch up after a stall
+		}
+
+		//wait() has a 1ms resolution, rounding a sub-millisecond remainder down to 0 would spin until the next tick
+		double msToWait = nextTickTime - Time::getMillisecondCounterHiRes();
+		if (msToWait > 0) wait(jmax(1, roundToInt(msToWait)));
+	}
+
+	processQueues();
+}
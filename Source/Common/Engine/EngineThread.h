@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    EngineThread.h
+    Created: 17 Oct 2026 2:40:02pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "LockFreeQueue.h"
+
+class EngineInputQueue :
+	public ReferenceCountedObject
+{
+public:
+	typedef std::function<void()> InputFunction;
+	typedef ReferenceCountedObjectPtr<EngineInputQueue> Ptr;
+
+	EngineInputQueue(const String& name, int capacity = 4096);
+	~EngineInputQueue();
+
+	String name;
+	LockFreeQueue<InputFunction> queue;
+	std::atomic<bool> isOpen;
+	std::atomic<int> numDropped;
+
+	bool push(InputFunction inputFunc);
+};
+
+class EngineThread :
+	public Thread
+{
+public:
+	juce_DeclareSingleton(EngineThread, true);
+
+	EngineThread();
+	~EngineThread();
+
+	//Held while an input function is executed, closing a queue waits for the current input to finish
+	CriticalSection processLock;
+	ReferenceCountedArray<EngineInputQueue, CriticalSection> queues;
+	ReferenceCountedArray<EngineInputQueue> queuesToProcess; //processing side copy of queues, only refreshed when a queue is created or closed
+	std::atomic<bool> queuesChanged;
+
+	EngineInputQueue::Ptr createInputQueue(const String& name);
+	void closeInputQueue(EngineInputQueue* q);
+
+	bool postInput(EngineInputQueue* q, EngineInputQueue::InputFunction inputFunc);
+
+	void start();
+	void stop();
+
+	void processQueues(int maxPerQueue = 1024);
+
+	void run() override;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EngineThread)
+};
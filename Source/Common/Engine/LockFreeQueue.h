@@ -0,0 +1,105 @@
+/*
+  ==============================================================================
+
+    LockFreeQueue.h
+    Created: 17 Oct 2026 2:41:18pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "JuceHeader.h"
+#include <atomic>
+
+/*
+	Bounded multi-producer queue, based on Dmitry Vyukov's sequenced ring buffer.
+	push() can be called from any number of threads, pop() is meant to be called from one consumer thread.
+	Neither of them ever blocks, push() returns false when the queue is full.
+	The ring buffer is allocated once, items are moved in and out of it : what an item owns (i.e. the captures of a std::function) is still allocated by the producer.
+*/
+template<class T>
+class LockFreeQueue
+{
+public:
+	LockFreeQueue(int capacity) :
+		numCells(nextPowerOfTwo(jmax(capacity, 2))),
+		mask((size_t)numCells - 1),
+		cells(new Cell[numCells]),
+		enqueuePos(0),
+		dequeuePos(0)
+	{
+		for (size_t i = 0; i < (size_t)numCells; i++) cells[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	~LockFreeQueue() {}
+
+	bool push(T item)
+	{
+		Cell* cell;
+		size_t pos = enqueuePos.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			cell = &cells[pos & mask];
+			size_t seq = cell->sequence.load(std::memory_order_acquire);
+			intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+			if (diff == 0)
+			{
+				if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+			}
+			else if (diff < 0) return false; //full
+			else pos = enqueuePos.load(std::memory_order_relaxed);
+		}
+
+		cell->data = std::move(item);
+		cell->sequence.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool pop(T& item)
+	{
+		Cell* cell;
+		size_t pos = dequeuePos.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			cell = &cells[pos & mask];
+			size_t seq = cell->sequence.load(std::memory_order_acquire);
+			intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+			if (diff == 0)
+			{
+				if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+			}
+			else if (diff < 0) return false; //empty
+			else pos = dequeuePos.load(std::memory_order_relaxed);
+		}
+
+		item = std::move(cell->data);
+		cell->data = T();
+		cell->sequence.store(pos + mask + 1, std::memory_order_release);
+		return true;
+	}
+
+	int getNumReady() const
+	{
+		return (int)(enqueuePos.load(std::memory_order_relaxed) - dequeuePos.load(std::memory_order_relaxed));
+	}
+
+	int getCapacity() const { return numCells; }
+
+private:
+	struct Cell
+	{
+		std::atomic<size_t> sequence;
+		T data;
+	};
+
+	const int numCells;
+	const size_t mask;
+	std::unique_ptr<Cell[]> cells;
+
+	alignas(64) std::atomic<size_t> enqueuePos;
+	alignas(64) std::atomic<size_t> dequeuePos;
+
+	JUCE_DECLARE_NON_COPYABLE(LockFreeQueue)
+};
@@ -0,0 +1,775 @@
+/*
+  ==============================================================================
+
+    OSCQueryServer.cpp
+    Created: 18 Oct 2026 1:02:37am
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "OSCQueryServer.h"
+#include "Common/WebSocket/WebSocketFrame.h"
+#include "Module/ModuleManager.h"
+#include "Module/modules/osc/transport/OSCPacketCodec.h"
+#include "CustomVariables/CVGroupManager.h"
+#include "StateMachine/StateManager.h"
+
+juce_ImplementSingleton(OSCQueryServer)
+
+namespace
+{
+	String getCommandString(const String &command, const String &data)
+	{
+		DynamicObject * o = new DynamicObject();
+		o->setProperty("COMMAND", command);
+		o->setProperty("DATA", data);
+		return JSON::toString(var(o), true);
+	}
+}
+
+OSCQueryServer::OSCQueryServer() :
+	ControllableContainer("OSCQuery Server"),
+	Thread("OSCQuery Server"),
+	servus("_oscjson._tcp"),
+	treeListener(this),
+	packetsUpdatePending(false)
+{
+	enableServer = addBoolParameter("Enabled", "If enabled, other applications can discover and control the modules, custom variables and states using OSCQuery", false);
+	port = addIntParameter("Port", "Port of the HTTP and WebSocket server. OSC messages sent over UDP on this port are also received", 42000, 1024, 65535);
+	maxUpdateRate = addIntParameter("Max Update Rate", "Maximum number of value updates sent to each client per second. Only the latest value of each address is sent", 60, 1, 1000);
+	numClients = addIntParameter("Clients", "Number of connected clients", 0, 0);
+	numClients->setControllableFeedbackOnly(true);
+	numClients->isSavable = false;
+
+	receiver.addListener(this);
+	receiver.registerFormatErrorHandler(&OSCHelpers::logOSCFormatError);
+
+	for (auto &cc : getExposedContainers()) cc->addControllableContainerListener(&treeListener);
+}
+
+OSCQueryServer::~OSCQueryServer()
+{
+	stopServer();
+	for (auto &cc : getExposedContainers()) cc->removeControllableContainerListener(&treeListener);
+}
+
+void OSCQueryServer::updateServer()
+{
+	stopServer();
+	if (!enableServer->boolValue()) return;
+
+	if (!serverSocket.createListener(port->intValue()))
+	{
+		NLOGERROR(niceName, "Error binding port " << port->intValue());
+		port->setWarningMessage("Error binding port " + port->stringValue());
+		return;
+	}
+
+	port->clearWarning();
+	if (!receiver.connect(port->intValue())) NLOGWARNING(niceName, "Could not receive OSC on UDP port " << port->intValue() << ", values can only be set through the WebSocket");
+
+	startThread();
+	NLOG(niceName, "Now serving on port " << port->intValue());
+}
+
+void OSCQueryServer::stopServer()
+{
+	signalThreadShouldExit();
+	serverSocket.close(); //unblocks waitForNextConnection
+	stopThread(2000);
+
+	receiver.disconnect();
+	servus.withdraw();
+	clients.clear();
+	numClients->setValue(0);
+}
+
+void OSCQueryServer::removeFinishedClients()
+{
+	const ScopedLock lock(clients.getLock());
+	for (int i = clients.size() - 1; i >= 0; i--) if (clients[i]->isFinished) clients.remove(i);
+	if (numClients->intValue() != clients.size()) numClients->setValue(clients.size());
+}
+
+Array<ControllableContainer*> OSCQueryServer::getExposedContainers()
+{
+	Array<ControllableContainer *> result;
+	if (ModuleManager::getInstanceWithoutCreating() != nullptr) result.add(ModuleManager::getInstance());
+	if (CVGroupManager::getInstanceWithoutCreating() != nullptr) result.add(CVGroupManager::getInstance());
+	if (StateManager::getInstanceWithoutCreating() != nullptr) result.add(StateManager::getInstance());
+	return result;
+}
+
+var OSCQueryServer::getHostInfo()
+{
+	var result(new DynamicObject());
+	result.getDynamicObject()->setProperty("NAME", "Chataigne");
+	result.getDynamicObject()->setProperty("OSC_PORT", port->intValue());
+	result.getDynamicObject()->setProperty("OSC_TRANSPORT", "UDP");
+
+	var extensions(new DynamicObject());
+	extensions.getDynamicObject()->setProperty("ACCESS", true);
+	extensions.getDynamicObject()->setProperty("VALUE", true);
+	extensions.getDynamicObject()->setProperty("RANGE", true);
+	extensions.getDynamicObject()->setProperty("DESCRIPTION", true);
+	extensions.getDynamicObject()->setProperty("LISTEN", true);
+	extensions.getDynamicObject()->setProperty("PATH_CHANGED", true);
+	result.getDynamicObject()->setProperty("EXTENSIONS", extensions);
+
+	return result;
+}
+
+var OSCQueryServer::getNodeDataForPath(const String & path)
+{
+	if (path.isEmpty() || path == "/")
+	{
+		var result(new DynamicObject());
+		result.getDynamicObject()->setProperty("FULL_PATH", "/");
+		result.getDynamicObject()->setProperty("ACCESS", 0);
+
+		var contents(new DynamicObject());
+		for (auto &cc : getExposedContainers()) contents.getDynamicObject()->setProperty(cc->shortName, getNodeData(cc, "/" + cc->shortName));
+		result.getDynamicObject()->setProperty("CONTENTS", contents);
+		return result;
+	}
+
+	String rootName = path.fromFirstOccurrenceOf("/", false, false).upToFirstOccurrenceOf("/", false, false);
+	for (auto &root : getExposedContainers())
+	{
+		if (root->shortName != rootName) continue;
+		if (path.endsWithChar('/') || path == "/" + rootName) return getNodeData(root, "/" + rootName);
+
+		if (Controllable * c = Engine::mainEngine->getControllableForAddress(path)) return getNodeData(c, path);
+		if (ControllableContainer * cc = Engine::mainEngine->getControllableContainerForAddress(path, true)) return getNodeData(cc, path);
+	}
+
+	return var();
+}
+
+var OSCQueryServer::getNodeData(ControllableContainer * cc, const String & path)
+{
+	var result(new DynamicObject());
+	result.getDynamicObject()->setProperty("FULL_PATH", path);
+	result.getDynamicObject()->setProperty("DESCRIPTION", cc->niceName);
+	result.getDynamicObject()->setProperty("ACCESS", 0);
+
+	var contents(new DynamicObject());
+	for (auto &c : cc->controllables)
+	{
+		var d = getNodeData(c, path + "/" + c->shortName);
+		if (!d.isVoid()) contents.getDynamicObject()->setProperty(c->shortName, d);
+	}
+
+	for (auto &childCC : cc->controllableContainers)
+	{
+		if (childCC.wasObjectDeleted()) continue;
+		contents.getDynamicObject()->setProperty(childCC->shortName, getNodeData(childCC, path + "/" + childCC->shortName));
+	}
+
+	result.getDynamicObject()->setProperty("CONTENTS", contents);
+	return result;
+}
+
+var OSCQueryServer::getNodeData(Controllable * c, const String & path)
+{
+	var result(new DynamicObject());
+	DynamicObject * o = result.getDynamicObject();
+	o->setProperty("FULL_PATH", path);
+	o->setProperty("DESCRIPTION", c->niceName);
+	o->setProperty("ACCESS", c->isControllableFeedbackOnly ? 1 : 3);
+
+	if (c->type == Controllable::TRIGGER)
+	{
+		o->setProperty("TYPE", "N");
+		o->setProperty("ACCESS", 2);
+		return result;
+	}
+
+	Parameter * p = dynamic_cast<Parameter *>(c);
+	if (p == nullptr) return var();
+
+	var value;
+	var range(new DynamicObject());
+
+	switch (p->type)
+	{
+	case Controllable::BOOL:
+		o->setProperty("TYPE", p->boolValue() ? "T" : "F");
+		value.append(p->boolValue());
+		break;
+
+	case Controllable::INT:
+	case Controllable::FLOAT:
+		o->setProperty("TYPE", p->type == Controllable::INT ? "i" : "f");
+		value.append(p->value);
+		if (p->hasRange())
+		{
+			range.getDynamicObject()->setProperty("MIN", p->minimumValue);
+			range.getDynamicObject()->setProperty("MAX", p->maximumValue);
+		}
+		break;
+
+	case Controllable::STRING:
+		o->setProperty("TYPE", "s");
+		value.append(p->stringValue());
+		break;
+
+	case Controllable::ENUM:
+	{
+		o->setProperty("TYPE", "s");
+		value.append(p->stringValue());
+		var vals;
+		for (auto &ev : ((EnumParameter *)p)->enumValues) vals.append(ev->key);
+		range.getDynamicObject()->setProperty("VALS", vals);
+	}
+	break;
+
+	case Controllable::COLOR:
+	{
+		Colour col = ((ColorParameter *)p)->getColor();
+		o->setProperty("TYPE", "r");
+		value.append(String::formatted("#%02X%02X%02X%02X", col.getRed(), col.getGreen(), col.getBlue(), col.getAlpha()));
+	}
+	break;
+
+	case Controllable::POINT2D:
+	case Controllable::POINT3D:
+		o->setProperty("TYPE", p->type == Controllable::POINT2D ? "ff" : "fff");
+		for (int i = 0; i < p->value.size(); i++) value.append(p->value[i]);
+		break;
+
+	default:
+		return var();
+	}
+
+	o->setProperty("VALUE", value);
+	if (range.getDynamicObject()->getProperties().size() > 0)
+	{
+		var ranges;
+		ranges.append(range);
+		o->setProperty("RANGE", ranges);
+	}
+
+	return result;
+}
+
+void OSCQueryServer::addValueArguments(OSCMessage & m, Controllable * c)
+{
+	Parameter * p = dynamic_cast<Parameter *>(c);
+	if (p == nullptr) return;
+
+	switch (p->type)
+	{
+	case Controllable::BOOL: m.addInt32(p->boolValue() ? 1 : 0); break;
+	case Controllable::INT: m.addInt32(p->intValue()); break;
+	case Controllable::FLOAT: m.addFloat32(p->floatValue()); break;
+	case Controllable::STRING:
+	case Controllable::ENUM: m.addString(p->stringValue()); break;
+
+	case Controllable::COLOR:
+	{
+		Colour col = ((ColorParameter *)p)->getColor();
+		m.addColour({ col.getRed(), col.getGreen(), col.getBlue(), col.getAlpha() });
+	}
+	break;
+
+	case Controllable::POINT2D:
+	case Controllable::POINT3D:
+		for (int i = 0; i < p->value.size(); i++) m.addFloat32(p->value[i]);
+		break;
+
+	default:
+		break;
+	}
+}
+
+void OSCQueryServer::postPacket(const OSCBundle::Element & e)
+{
+	{
+		GenericScopedLock<SpinLock> lock(pendingPacketsLock);
+		pendingPackets.add(e);
+	}
+
+	//packets received until the message thread applies them are applied together
+	if (packetsUpdatePending.exchange(true)) return;
+
+	MessageManager::callAsync([]()
+	{
+		if (OSCQueryServer * server = OSCQueryServer::getInstanceWithoutCreating()) server->applyPendingPackets();
+	});
+}
+
+void OSCQueryServer::applyPendingPackets()
+{
+	packetsUpdatePending = false;
+
+	Array<OSCBundle::Element> packets;
+	{
+		GenericScopedLock<SpinLock> lock(pendingPacketsLock);
+		packets.swapWith(pendingPackets);
+	}
+
+	for (auto &e : packets) applyPacket(e);
+}
+
+void OSCQueryServer::applyPacket(const OSCBundle::Element & e)
+{
+	if (e.isBundle())
+	{
+		for (auto &child : e.getBundle()) applyPacket(child);
+		return;
+	}
+
+	applyMessage(e.getMessage());
+}
+
+void OSCQueryServer::applyMessage(const OSCMessage & m)
+{
+	String address = m.getAddressPattern().toString();
+	String rootName = address.fromFirstOccurrenceOf("/", false, false).upToFirstOccurrenceOf("/", false, false);
+
+	bool isExposed = false;
+	for (auto &root : getExposedContainers()) if (root->shortName == rootName) isExposed = true;
+	if (!isExposed) return;
+
+	Controllable * c = Engine::mainEngine->getControllableForAddress(address);
+	if (c == nullptr || c->isControllableFeedbackOnly) return;
+
+	if (c->type == Controllable::TRIGGER)
+	{
+		((Trigger *)c)->trigger();
+		return;
+	}
+
+	if (m.isEmpty()) return;
+
+	Parameter * p = (Parameter *)c;
+	auto getArgValue = [](const OSCArgument &a) -> var
+	{
+		if (a.isFloat32()) return a.getFloat32();
+		if (a.isInt32()) return a.getInt32();
+		if (a.isString()) return a.getString();
+		return var();
+	};
+
+	switch (p->type)
+	{
+	case Controllable::BOOL: p->setValue((float)getArgValue(m[0]) > 0); break;
+
+	case Controllable::COLOR:
+		if (m[0].isColour())
+		{
+			OSCColour col = m[0].getColour();
+			((ColorParameter *)p)->setColor(Colour(col.red, col.green, col.blue, col.alpha));
+		}
+		else if (m.size() >= 3)
+		{
+			((ColorParameter *)p)->setColor(Colour::fromFloatRGBA(getArgValue(m[0]), getArgValue(m[1]), getArgValue(m[2]), m.size() >= 4 ? (float)getArgValue(m[3]) : 1.0f));
+		}
+		break;
+
+	case Controllable::POINT2D:
+	case Controllable::POINT3D:
+	{
+		var value;
+		for (auto &a : m) value.append(getArgValue(a));
+		if (value.size() >= p->value.size()) p->setValue(value);
+	}
+	break;
+
+	default:
+	{
+		var value = getArgValue(m[0]);
+		if (!value.isVoid()) p->setValue(value);
+	}
+	break;
+	}
+}
+
+void OSCQueryServer::onContainerParameterChanged(Parameter * p)
+{
+	if (p == enableServer || p == port) updateServer();
+}
+
+void OSCQueryServer::TreeListener::controllableFeedbackUpdate(ControllableContainer *, Controllable * c)
+{
+	server->valueChanged(c);
+}
+
+void OSCQueryServer::TreeListener::childStructureChanged(ControllableContainer * cc)
+{
+	server->structureChanged(cc);
+}
+
+void OSCQueryServer::valueChanged(Controllable * c)
+{
+	if (!isThreadRunning()) return;
+
+	String address = c->getControlAddress();
+	std::unique_ptr<OSCMessage> m;
+
+	const ScopedLock lock(clients.getLock());
+	for (auto &client : clients)
+	{
+		if (!client->isWebSocket || !client->isListening(address)) continue;
+
+		if (m == nullptr)
+		{
+			//built once for all the clients, on the thread that changed the value
+			try
+			{
+				m.reset(new OSCMessage(address));
+				addValueArguments(*m, c);
+			}
+			catch (OSCFormatError &)
+			{
+				return; //address not valid in OSC, can't be listened to
+			}
+		}
+
+		client->valueChanged(*m);
+	}
+}
+
+void OSCQueryServer::structureChanged(ControllableContainer * cc)
+{
+	if (!isThreadRunning()) return;
+
+	//notify the exposed root that changed, after the changes settle down
+	Array<ControllableContainer *> roots = getExposedContainers();
+	while (cc != nullptr && !roots.contains(cc)) cc = cc->parentContainer;
+	if (cc == nullptr) return;
+
+	{
+		GenericScopedLock<SpinLock> lock(structureLock);
+		changedRoots.addIfNotAlreadyThere(cc);
+	}
+
+	startTimer(500);
+}
+
+void OSCQueryServer::timerCallback()
+{
+	stopTimer();
+
+	Array<ControllableContainer *> roots;
+	{
+		GenericScopedLock<SpinLock> lock(structureLock);
+		roots.swapWith(changedRoots);
+	}
+
+	const ScopedLock lock(clients.getLock());
+	for (auto &root : roots)
+	{
+		String message = getCommandString("PATH_CHANGED", "/" + root->shortName);
+		for (auto &client : clients) if (client->isWebSocket) client->postText(message);
+	}
+}
+
+void OSCQueryServer::oscMessageReceived(const OSCMessage & m)
+{
+	postPacket(OSCBundle::Element(m));
+}
+
+void OSCQueryServer::oscBundleReceived(const OSCBundle & b)
+{
+	postPacket(OSCBundle::Element(b));
+}
+
+void OSCQueryServer::run()
+{
+	servus.announce(port->intValue(), "Chataigne");
+
+	while (!threadShouldExit())
+	{
+		removeFinishedClients();
+
+		//poll rather than block in accept, so the client count is updated as soon as a client leaves
+		int ready = serverSocket.waitUntilReady(true, 100);
+		if (ready < 0) break;
+		if (ready == 0) continue;
+
+		StreamingSocket * s = serverSocket.waitForNextConnection();
+		if (s == nullptr)
+		{
+			if (!serverSocket.isConnected()) break;
+			continue;
+		}
+
+		if (threadShouldExit())
+		{
+			delete s;
+			break;
+		}
+
+		Client * c = new Client(this, s);
+		clients.add(c);
+		c->startThread();
+
+		numClients->setValue(clients.size());
+	}
+}
+
+
+// CLIENT
+
+OSCQueryServer::Client::Client(OSCQueryServer * server, StreamingSocket * socket) :
+	Thread("OSCQuery Client " + socket->getHostName()),
+	server(server),
+	socket(socket),
+	isWebSocket(false),
+	isFinished(false),
+	lastFlushTime(0)
+{
+}
+
+OSCQueryServer::Client::~Client()
+{
+	signalThreadShouldExit();
+	socket->close();
+	stopThread(1000);
+}
+
+bool OSCQueryServer::Client::isListening(const String & address)
+{
+	GenericScopedLock<SpinLock> lock(listenLock);
+	return listenedAddresses.contains(address);
+}
+
+void OSCQueryServer::Client::valueChanged(const OSCMessage & m)
+{
+	String address = m.getAddressPattern().toString();
+
+	GenericScopedLock<SpinLock> lock(pendingLock);
+	if (pendingIndices.contains(address)) pendingValues.set(pendingIndices[address], m);
+	else
+	{
+		pendingIndices.set(address, pendingValues.size());
+		pendingValues.add(m);
+	}
+}
+
+void OSCQueryServer::Client::postText(const String & message)
+{
+	GenericScopedLock<SpinLock> lock(pendingLock);
+	pendingTexts.add(message);
+}
+
+bool OSCQueryServer::Client::sendText(const String & message)
+{
+	MemoryBlock frame = WebSocketFrame::encode(WebSocketFrame::TEXT, message.toRawUTF8(), message.getNumBytesAsUTF8(), false);
+	return writeBytes(frame.getData(), (int)frame.getSize());
+}
+
+bool OSCQueryServer::Client::sendData(const MemoryBlock & data)
+{
+	MemoryBlock frame = WebSocketFrame::encode(WebSocketFrame::BINARY, data.getData(), data.getSize(), false);
+	return writeBytes(frame.getData(), (int)frame.getSize());
+}
+
+bool OSCQueryServer::Client::writeBytes(const void * data, int numBytes)
+{
+	//a frame cut in the middle can't be resumed, the client is dropped and the server removes it
+	if (socket->write(data, numBytes) == numBytes) return true;
+
+	NLOGWARNING(server->niceName, "Error writing to " << socket->getHostName() << ", closing the connection");
+	signalThreadShouldExit();
+	return false;
+}
+
+void OSCQueryServer::Client::run()
+{
+	if (!handleHTTPRequest())
+	{
+		isFinished = true;
+		return;
+	}
+
+	MemoryBlock message;
+	int messageOpcode = 0;
+
+	while (!threadShouldExit())
+	{
+		int ready = socket->waitUntilReady(true, 5);
+		if (ready < 0) break;
+
+		if (ready > 0)
+		{
+			int opcode = 0;
+			bool isFinal = false;
+			MemoryBlock payload;
+			if (!WebSocketFrame::read(*socket, opcode, isFinal, payload, this)) break;
+
+			if (opcode == WebSocketFrame::PING)
+			{
+				MemoryBlock frame = WebSocketFrame::encode(WebSocketFrame::PONG, payload.getData(), payload.getSize(), false);
+				writeBytes(frame.getData(), (int)frame.getSize());
+			}
+			else if (opcode == WebSocketFrame::CLOSE) break;
+			else if (opcode == WebSocketFrame::TEXT || opcode == WebSocketFrame::BINARY)
+			{
+				messageOpcode = opcode;
+				message = payload;
+			}
+			else if (opcode == WebSocketFrame::CONTINUATION && messageOpcode != 0) message.append(payload.getData(), payload.getSize());
+
+			if (isFinal && messageOpcode != 0)
+			{
+				if (messageOpcode == WebSocketFrame::TEXT) handleWebSocketMessage(message.toString());
+				else
+				{
+					try
+					{
+						server->postPacket(OSCPacketCodec::readPacket(message.getData(), message.getSize()));
+					}
+					catch (OSCFormatError &e)
+					{
+						NLOGWARNING(server->niceName, "Error reading OSC from " << socket->getHostName() << " : " << e.description);
+					}
+				}
+				messageOpcode = 0;
+			}
+		}
+
+		flushPendingTexts();
+
+		uint32 t = Time::getMillisecondCounter();
+		if (t - lastFlushTime >= (uint32)(1000 / server->maxUpdateRate->intValue()))
+		{
+			flushPendingValues();
+			lastFlushTime = t;
+		}
+	}
+
+	isFinished = true;
+}
+
+bool OSCQueryServer::Client::handleHTTPRequest()
+{
+	MemoryOutputStream request;
+	uint32 startTime = Time::getMillisecondCounter();
+	while (!request.toString().endsWith("\r\n\r\n"))
+	{
+		if (threadShouldExit() || request.getDataSize() > 16384 || Time::getMillisecondCounter() - startTime > 5000) return false;
+
+		int ready = socket->waitUntilReady(true, 100);
+		if (ready < 0) return false;
+		if (ready == 0) continue;
+
+		char c;
+		if (socket->read(&c, 1, false) <= 0) return false;
+		request.writeByte(c);
+	}
+
+	StringArray lines = StringArray::fromLines(request.toString());
+	StringArray requestLine = StringArray::fromTokens(lines[0], " ", "");
+	if (requestLine.size() < 2 || requestLine[0] != "GET")
+	{
+		sendHTTPResponse(400, "Bad Request", "");
+		return false;
+	}
+
+	StringPairArray headers;
+	for (int i = 1; i < lines.size(); i++)
+	{
+		if (lines[i].isEmpty()) continue;
+		headers.set(lines[i].upToFirstOccurrenceOf(":", false, false).trim(), lines[i].fromFirstOccurrenceOf(":", false, false).trim());
+	}
+
+	if (headers["Upgrade"].equalsIgnoreCase("websocket"))
+	{
+		String response = "HTTP/1.1 101 Switching Protocols\r\n"
+			"Upgrade: websocket\r\n"
+			"Connection: Upgrade\r\n"
+			"Sec-WebSocket-Accept: " + WebSocketFrame::getAcceptKey(headers["Sec-WebSocket-Key"]) + "\r\n\r\n";
+
+		if (!writeBytes(response.toRawUTF8(), (int)response.getNumBytesAsUTF8())) return false;
+		isWebSocket = true;
+		return true;
+	}
+
+	String target = URL::removeEscapeChars(requestLine[1]);
+	String path = target.upToFirstOccurrenceOf("?", false, false);
+	String query = target.fromFirstOccurrenceOf("?", false, false);
+
+	var data;
+	if (query == "HOST_INFO") data = server->getHostInfo();
+	else
+	{
+		//the tree is read with the message thread locked, so it can't change meanwhile
+		const MessageManagerLock mmLock(this);
+		if (!mmLock.lockWasGained()) return false;
+
+		data = server->getNodeDataForPath(path);
+		if (!data.isVoid() && query.isNotEmpty())
+		{
+			var attribute = data.getProperty(query, var());
+			data = var(new DynamicObject());
+			if (!attribute.isVoid()) data.getDynamicObject()->setProperty(query, attribute);
+		}
+	}
+
+	if (data.isVoid()) sendHTTPResponse(404, "Not Found", "");
+	else sendHTTPResponse(200, "OK", JSON::toString(data, true));
+
+	return false;
+}
+
+void OSCQueryServer::Client::handleWebSocketMessage(const String & message)
+{
+	var data = JSON::parse(message);
+	String command = data.getProperty("COMMAND", "").toString();
+	String address = data.getProperty("DATA", "").toString();
+
+	GenericScopedLock<SpinLock> lock(listenLock);
+	if (command == "LISTEN") listenedAddresses.set(address, true);
+	else if (command == "IGNORE") listenedAddresses.remove(address);
+}
+
+void OSCQueryServer::Client::sendHTTPResponse(int status, const String & statusText, const String & body)
+{
+	String response = "HTTP/1.1 " + String(status) + " " + statusText + "\r\n"
+		+ "Content-Type: application/json\r\n"
+		+ "Content-Length: " + String(body.getNumBytesAsUTF8()) + "\r\n"
+		+ "Access-Control-Allow-Origin: *\r\n"
+		+ "Connection: close\r\n\r\n"
+		+ body;
+
+	writeBytes(response.toRawUTF8(), (int)response.getNumBytesAsUTF8());
+}
+
+void OSCQueryServer::Client::flushPendingTexts()
+{
+	StringArray texts;
+	{
+		GenericScopedLock<SpinLock> lock(pendingLock);
+		if (pendingTexts.isEmpty()) return;
+		texts.swapWith(pendingTexts);
+	}
+
+	for (auto &t : texts) if (!sendText(t)) return;
+}
+
+void OSCQueryServer::Client::flushPendingValues()
+{
+	Array<OSCMessage> values;
+	{
+		GenericScopedLock<SpinLock> lock(pendingLock);
+		if (pendingValues.size() == 0) return;
+		values.swapWith(pendingValues);
+		pendingIndices.clear();
+	}
+
+	//all the changes since the last flush go in one frame
+	MemoryOutputStream os;
+	if (values.size() == 1) OSCPacketCodec::writeMessage(os, values[0]);
+	else
+	{
+		OSCBundle bundle;
+		for (auto &m : values) bundle.addElement(m);
+		OSCPacketCodec::writeBundle(os, bundle);
+	}
+
+	sendData(os.getMemoryBlock());
+}
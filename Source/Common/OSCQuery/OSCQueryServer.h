@@ -0,0 +1,134 @@
+/*
+  ==============================================================================
+
+    OSCQueryServer.h
+    Created: 18 Oct 2026 1:02:37am
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "JuceHeader.h"
+#include "servus/servus.h"
+
+/*
+	OSCQuery server exposing the modules, custom variables and states.
+	HTTP requests get the namespace as JSON, WebSocket clients can LISTEN to values and are notified of namespace changes.
+	Values can be set with OSC over UDP on the same port number, or with binary OSC frames on the WebSocket.
+*/
+class OSCQueryServer :
+	public ControllableContainer,
+	public OSCReceiver::Listener<OSCReceiver::RealtimeCallback>,
+	public Thread,
+	public Timer
+{
+public:
+	juce_DeclareSingleton(OSCQueryServer, true);
+
+	OSCQueryServer();
+	~OSCQueryServer();
+
+	BoolParameter * enableServer;
+	IntParameter * port;
+	IntParameter * maxUpdateRate;
+	IntParameter * numClients;
+
+	class Client :
+		public Thread
+	{
+	public:
+		Client(OSCQueryServer * server, StreamingSocket * socket);
+		~Client();
+
+		OSCQueryServer * server;
+		std::unique_ptr<StreamingSocket> socket;
+		std::atomic<bool> isWebSocket;
+		std::atomic<bool> isFinished;
+
+		SpinLock listenLock;
+		HashMap<String, bool> listenedAddresses;
+
+		//latest change of each listened value, sent at most maxUpdateRate times per second.
+		//The messages are built by the thread that changed the value, the client thread never reads the parameters
+		SpinLock pendingLock;
+		HashMap<String, int> pendingIndices;
+		Array<OSCMessage> pendingValues;
+		uint32 lastFlushTime;
+
+		//commands posted by the other threads, written by the client thread so a client that stops reading only blocks itself
+		StringArray pendingTexts;
+
+		bool isListening(const String &address);
+		void valueChanged(const OSCMessage &m);
+		void postText(const String &message);
+		bool sendText(const String &message);
+		bool sendData(const MemoryBlock &data);
+
+		void run() override;
+
+	private:
+		bool handleHTTPRequest(); //returns true if the connection was upgraded to a WebSocket
+		void handleWebSocketMessage(const String &message);
+		void sendHTTPResponse(int status, const String &statusText, const String &body);
+		void flushPendingTexts();
+		void flushPendingValues();
+		bool writeBytes(const void * data, int numBytes); //stops the client on a failed or short write
+	};
+
+	StreamingSocket serverSocket;
+	OwnedArray<Client, CriticalSection> clients;
+	OSCReceiver receiver;
+	servus::Servus servus;
+
+	//listens to the exposed containers, kept apart so it doesn't override this container's own notifications
+	class TreeListener :
+		public ControllableContainerListener
+	{
+	public:
+		TreeListener(OSCQueryServer * server) : server(server) {}
+		OSCQueryServer * server;
+
+		void controllableFeedbackUpdate(ControllableContainer * cc, Controllable * c) override;
+		void childStructureChanged(ControllableContainer * cc) override;
+	};
+
+	TreeListener treeListener;
+	SpinLock structureLock;
+	Array<ControllableContainer *> changedRoots;
+
+	//values received on the UDP and WebSocket threads are applied on the message thread
+	SpinLock pendingPacketsLock;
+	Array<OSCBundle::Element> pendingPackets;
+	std::atomic<bool> packetsUpdatePending;
+
+	void updateServer();
+	void stopServer();
+	void removeFinishedClients();
+
+	Array<ControllableContainer *> getExposedContainers();
+	var getHostInfo();
+	var getNodeDataForPath(const String &path);
+	var getNodeData(ControllableContainer * cc, const String &path);
+	var getNodeData(Controllable * c, const String &path);
+
+	static void addValueArguments(OSCMessage &m, Controllable * c);
+	void postPacket(const OSCBundle::Element &e);
+	void applyPendingPackets();
+	void applyPacket(const OSCBundle::Element &e);
+	void applyMessage(const OSCMessage &m);
+
+	void onContainerParameterChanged(Parameter * p) override;
+
+	void valueChanged(Controllable * c);
+	void structureChanged(ControllableContainer * root);
+
+	void oscMessageReceived(const OSCMessage &m) override;
+	void oscBundleReceived(const OSCBundle &b) override;
+
+	void run() override;
+	void timerCallback() override;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OSCQueryServer)
+};
@@ -25,7 +25,6 @@ ConditionManager::ConditionManager(bool _operatorOnSide) :
     operatorOnSide(_operatorOnSide),
     validationProgress(nullptr),
 	validationWaiting(false),
-    prevTimerTime(0),
     forceDisabled(false)
 {
 	
@@ -59,6 +58,7 @@ ConditionManager::ConditionManager(bool _operatorOnSide) :
 
 ConditionManager::~ConditionManager()
 {
+	if (EngineClock::getInstanceWithoutCreating() != nullptr) EngineClock::getInstance()->removeClockListener(this);
 }
 
 
@@ -147,13 +147,11 @@ void ConditionManager::checkAllConditions(bool emptyIsValid, bool dispatchOnlyOn
 
 		if(!valid)
 		{
-			stopTimer();
+			EngineClock::getInstance()->removeClockListener(this);
 			dispatchConditionValidationChanged();
 		} else
 		{
-
-			prevTimerTime = Time::getHighResolutionTicks();
-			startTimer(20);
+			EngineClock::getInstance()->addClockListener(this);
 		}
 	}
 }
@@ -195,26 +193,23 @@ InspectableEditor * ConditionManager::getEditor(bool isRoot)
 	return new ConditionManagerEditor(this, isRoot);
 }
 
-void ConditionManager::timerCallback()
+void ConditionManager::engineTick(double deltaTime)
 {
 	if (validationTime->floatValue() == 0)
 	{
 		isValid->setValue(true);
 		dispatchConditionValidationChanged();
-		stopTimer();
+		EngineClock::getInstance()->removeClockListener(this);
 		return;
 	}
 
-	double curTime = Time::getMillisecondCounterHiRes();
-	validationProgress->setValue(validationProgress->floatValue() + (curTime - prevTimerTime)/1000.f);
-	prevTimerTime = curTime;
-
+	validationProgress->setValue(validationProgress->floatValue() + deltaTime);
 
 	if (validationProgress->floatValue() >= validationTime->floatValue())
 	{
 		isValid->setValue(true);
 		dispatchConditionValidationChanged();
-		stopTimer();
+		EngineClock::getInstance()->removeClockListener(this);
 	}
 }
 
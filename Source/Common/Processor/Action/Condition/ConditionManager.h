@@ -11,11 +11,12 @@
 #pragma once
 
 #include "Condition.h"
+#include "Common/Engine/EngineClock.h"
 
 class ConditionManager :
 	public BaseManager<Condition>,
 	public Condition::ConditionListener,
-	public Timer
+	public EngineClock::ClockListener
 {
 public:
 	juce_DeclareSingleton(ConditionManager, true)
@@ -37,7 +38,6 @@ public:
 	FloatParameter* validationProgress;
 
 	bool validationWaiting;
-	double prevTimerTime;
 	bool forceDisabled;
 
 	void setHasActivationDefinitions(bool value);
@@ -83,7 +83,6 @@ public:
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ConditionManager)
 
 
-		// Inherited via Timer
-		virtual void timerCallback() override;
+	void engineTick(double deltaTime) override;
 
 };
\ No newline at end of file
@@ -11,14 +11,16 @@
 #include "LagFilter.h"
 
 LagFilter::LagFilter(var params) :
-	MappingFilter(getTypeString())
+	MappingFilter(getTypeString()),
+	timeSinceLastSample(0)
 {
 	frequency = filterParams.addFloatParameter("Frequency", "Lag frequency in Hz", 5, .01f, 50);
-	startTimerHz(frequency->floatValue());
+	EngineClock::getInstance()->addClockListener(this);
 }
 
 LagFilter::~LagFilter()
 {
+	if (EngineClock::getInstanceWithoutCreating() != nullptr) EngineClock::getInstance()->removeClockListener(this);
 }
 
 void LagFilter::processInternal()
@@ -28,11 +30,17 @@ void LagFilter::processInternal()
 
 void LagFilter::filterParamChanged(Parameter * p)
 {
-	if(p == frequency) startTimerHz(frequency->floatValue());
+	if (p == frequency) timeSinceLastSample = 0;
 }
 
-void LagFilter::timerCallback()
+void LagFilter::engineTick(double deltaTime)
 {
 	if (sourceParam == nullptr) return;
+
+	double period = 1.0 / frequency->floatValue();
+	timeSinceLastSample += deltaTime;
+	if (timeSinceLastSample < period) return;
+
+	timeSinceLastSample = jmin(timeSinceLastSample - period, period);
 	tempVal = sourceParam->value;
 }
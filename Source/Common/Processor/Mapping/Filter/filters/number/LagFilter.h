@@ -11,10 +11,11 @@
 #pragma once
 
 #include "../../MappingFilter.h"
+#include "Common/Engine/EngineClock.h"
 
 class LagFilter :
 	public MappingFilter,
-	public Timer
+	public EngineClock::ClockListener
 {
 public:
 	LagFilter(var params);
@@ -22,6 +23,7 @@ public:
 
 	var tempVal;
 	FloatParameter * frequency;
+	double timeSinceLastSample;
 
 	void processInternal() override;
 
@@ -31,7 +33,6 @@ public:
 	String getTypeString() const override { return "FPS"; }
 
 
-	// Inherited via Timer
-	virtual void timerCallback() override;
+	virtual void engineTick(double deltaTime) override;
 
 };
\ No newline at end of file
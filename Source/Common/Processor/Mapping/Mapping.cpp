@@ -16,6 +16,7 @@ Mapping::Mapping(bool canBeDisabled) :
 	outputParam(nullptr),
     processMode(VALUE_CHANGE),
     inputIsLocked(false),
+	timeToNextProcess(0),
     mappingAsyncNotifier(10)
 {
 	itemDataType = "Mapping";
@@ -37,6 +38,7 @@ Mapping::Mapping(bool canBeDisabled) :
 
 Mapping::~Mapping()
 {
+	if (EngineClock::getInstanceWithoutCreating() != nullptr) EngineClock::getInstance()->removeClockListener(this);
 	clearItem();
 }
 
@@ -181,8 +183,8 @@ void Mapping::onContainerParameterChangedInternal(Parameter * p)
 	BaseItem::onContainerParameterChangedInternal(p);
 	if (p == continuousProcess)
 	{
-		if (continuousProcess->boolValue()) startTimerHz(30);
-		else stopTimer();
+		if (continuousProcess->boolValue()) EngineClock::getInstance()->addClockListener(this);
+		else EngineClock::getInstance()->removeClockListener(this);
 	} else if (p == outputParam)
 	{
 		om.setValue(outputParam->getValue());
@@ -234,9 +236,14 @@ ProcessorUI * Mapping::getUI()
 	return new MappingUI(this);
 }
 
-void Mapping::timerCallback()
+void Mapping::engineTick(double deltaTime)
 {
 	if ((canBeDisabled && !enabled->boolValue()) || forceDisabled) return;
+
+	timeToNextProcess -= deltaTime;
+	if (timeToNextProcess > 0) return;
+	timeToNextProcess = jmax<double>(timeToNextProcess + 1.0 / EngineClock::getInstance()->continuousMappingRate->intValue(), 0);
+
 	process();
 }
 
@@ -15,11 +15,12 @@
 #include "Filter/MappingFilterManager.h"
 #include "Output/MappingOutputManager.h"
 #include "../Action/Condition/ConditionManager.h"
+#include "Common/Engine/EngineClock.h"
 
 class Mapping :
 	public Processor,
 	public MappingInput::Listener,
-	public Timer,
+	public EngineClock::ClockListener,
 	public MappingFilterManager::BaseManager::AsyncListener,
 	public MappingFilter::FilterListener,
 	public MappingFilter::AsyncListener
@@ -34,6 +35,7 @@ public:
 	MappingOutputManager om;
 
 	BoolParameter * continuousProcess;
+	double timeToNextProcess;
 
 	Parameter * outputParam;
 
@@ -68,7 +70,7 @@ public:
 
 	virtual void clearItem() override;
 
-	virtual void timerCallback() override;
+	virtual void engineTick(double deltaTime) override;
 
 	virtual void highlightLinkedInspectables(bool value) override;
 
@@ -0,0 +1,105 @@
+/*
+  ==============================================================================
+
+    COBSFrameDecoder.cpp
+    Created: 18 Oct 2026 2:14:52am
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "COBSFrameDecoder.h"
+
+COBSFrameDecoder::COBSFrameDecoder(size_t maxFrameSize) :
+	maxFrameSize(maxFrameSize),
+	numInvalidFrames(0),
+	isSkipping(false)
+{
+}
+
+COBSFrameDecoder::~COBSFrameDecoder()
+{
+}
+
+void COBSFrameDecoder::process(const uint8 * data, size_t size, FrameFunction onFrame)
+{
+	const uint8 * end = data + size;
+	while (data < end)
+	{
+		const uint8 * delimiter = (const uint8 *)memchr(data, 0, (size_t)(end - data));
+		if (delimiter == nullptr)
+		{
+			if (!isSkipping) pending.insert(pending.end(), data, end);
+			if (pending.size() > maxFrameSize)
+			{
+				pending.clear();
+				isSkipping = true;
+				numInvalidFrames++;
+			}
+			return;
+		}
+
+		if (isSkipping) isSkipping = false;
+		else if (pending.empty()) decodeFrame(data, (size_t)(delimiter - data), onFrame);
+		else
+		{
+			pending.insert(pending.end(), data, delimiter);
+			decodeFrame(pending.data(), pending.size(), onFrame);
+			pending.clear();
+		}
+
+		data = delimiter + 1;
+	}
+}
+
+void COBSFrameDecoder::flush(FrameFunction onFrame)
+{
+	if (!isSkipping && !pending.empty()) decodeFrame(pending.data(), pending.size(), onFrame);
+	reset();
+}
+
+void COBSFrameDecoder::reset()
+{
+	pending.clear();
+	isSkipping = false;
+}
+
+void COBSFrameDecoder::decodeFrame(const uint8 * data, size_t size, FrameFunction & onFrame)
+{
+	if (size == 0) return; //consecutive delimiters
+
+	if (decoded.size() < size) decoded.resize(size);
+	size_t decodedSize = 0;
+	if (!decode(data, size, decoded.data(), decodedSize))
+	{
+		numInvalidFrames++;
+		return;
+	}
+
+	onFrame(decoded.data(), decodedSize);
+}
+
+bool COBSFrameDecoder::decode(const uint8 * input, size_t length, uint8 * output, size_t & decodedSize)
+{
+	size_t readIndex = 0;
+	size_t writeIndex = 0;
+
+	while (readIndex < length)
+	{
+		const uint8 code = input[readIndex++];
+		if (code == 0) return false;
+
+		const size_t numBytes = (size_t)code - 1;
+		if (readIndex + numBytes > length) return false;
+
+		memcpy(output + writeIndex, input + readIndex, numBytes);
+		readIndex += numBytes;
+		writeIndex += numBytes;
+
+		//each group but the last one and the full ones (0xFF) stands for a 0
+		if (code != 0xFF && readIndex < length) output[writeIndex++] = 0;
+	}
+
+	decodedSize = writeIndex;
+	return true;
+}
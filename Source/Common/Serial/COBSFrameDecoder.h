@@ -0,0 +1,43 @@
+/*
+  ==============================================================================
+
+    COBSFrameDecoder.h
+    Created: 18 Oct 2026 2:14:52am
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "JuceHeader.h"
+
+/*
+	Splits a COBS encoded byte stream on its 0 delimiters and decodes the frames, whatever their size.
+	Frames that are complete within a received chunk are decoded straight from it, only the incomplete tail is kept for the next chunk.
+*/
+class COBSFrameDecoder
+{
+public:
+	COBSFrameDecoder(size_t maxFrameSize = 16 * 1024 * 1024);
+	~COBSFrameDecoder();
+
+	typedef std::function<void(const uint8 * data, size_t size)> FrameFunction;
+
+	size_t maxFrameSize;
+	int numInvalidFrames;
+
+	void process(const uint8 * data, size_t size, FrameFunction onFrame);
+	void flush(FrameFunction onFrame); //decodes the pending bytes as a last frame, for transports that already delimit frames (i.e. datagrams)
+	void reset();
+
+	//input is the encoded frame without its delimiter, output must hold at least length bytes. Returns false if the frame is not valid COBS
+	static bool decode(const uint8 * input, size_t length, uint8 * output, size_t &decodedSize);
+
+private:
+	std::vector<uint8> pending;
+	std::vector<uint8> decoded;
+	bool isSkipping; //the current frame went over maxFrameSize, its bytes are dropped until the next delimiter
+
+	void decodeFrame(const uint8 * data, size_t size, FrameFunction &onFrame);
+};
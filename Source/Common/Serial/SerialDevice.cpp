@@ -43,15 +43,8 @@ SerialDevice::~SerialDevice()
 void SerialDevice::setMode(PortMode _mode)
 {
 	if (mode == _mode) return; //do nothing if the same
+	mode = _mode; //the read thread drops its pending bytes when it sees the change
 
-	if (_mode == LINES) //must restart to make sure thread is not hanging in readLine
-	{
-		thread.signalThreadShouldExit();
-		thread.stopThread(1000);
-		thread.startThread();
-	}
-
-	mode = _mode;
 }
 
 void SerialDevice::setBaudRate(int baudRate)
@@ -75,6 +68,15 @@ void SerialDevice::open(int baud)
 	try
 	{
 		port->setBaudrate(baud);
+
+		//reads wake up as soon as data arrives, or after a short timeout to check if the read thread should exit
+#if JUCE_WINDOWS
+		Timeout readTimeout(Timeout::max(), SerialReadThread::readTimeoutMs, Timeout::max(), 1000, 0);
+#else
+		Timeout readTimeout(Timeout::max(), SerialReadThread::readTimeoutMs, 0, 1000, 0);
+#endif
+		port->setTimeout(readTimeout);
+
 		if (!port->isOpen())  port->open();
 		port->setDTR();
 		port->setRTS();
@@ -207,87 +209,60 @@ void SerialReadThread::run()
 {
 #if SERIALSUPPORT
 	
-	std::vector<uint8_t> byteBuffer; //for cobs and data255
+	std::vector<uint8_t> pending; //received bytes not yet part of a complete line or frame
+	size_t numScanned = 0; //bytes of pending already searched for a delimiter
+	SerialDevice::PortMode lastMode = port->mode;
+	uint8_t readBuffer[4096];
 
 	DBG("START SERIAL THREAD");
 
 	while (!threadShouldExit())
 	{
-		sleep(2); //500fps
-
 		if (port == nullptr) return;
 		if (!port->isOpen()) return;
 
 		try
 		{
-
-			size_t numBytes = (int)port->port->available();
+#if JUCE_WINDOWS
+			//with the timeouts set on open, read returns as soon as some bytes are received
+			size_t numBytes = port->port->read(readBuffer, sizeof(readBuffer));
+#else
+			if (!port->port->waitReadable()) continue;
+			size_t numBytes = port->port->read(readBuffer, jmin(jmax<size_t>(port->port->available(), 1), sizeof(readBuffer)));
+#endif
 			if (numBytes == 0) continue;
 
-			switch (port->mode)
+			if (port->mode != lastMode)
 			{
-
-			case SerialDevice::PortMode::LINES:
-			{
-				while (port->port->available())
-				{
-					std::string line = port->port->readline();
-					if(line.size() > 0) serialThreadListeners.call(&SerialThreadListener::dataReceived, var(line));
-				}
+				pending.clear();
+				numScanned = 0;
+				cobsDecoder.reset();
+				lastMode = port->mode;
 			}
-			break;
 
-			case SerialDevice::PortMode::RAW:
+			if (port->mode == SerialDevice::PortMode::RAW)
 			{
-				std::vector<uint8_t> data;
-				port->port->read(data,numBytes);
-				//for (int i = 0; i < data.size(); i++) DBG("Data " << data[i]);
-				serialThreadListeners.call(&SerialThreadListener::dataReceived, var(data.data(),numBytes));
+				serialThreadListeners.call(&SerialThreadListener::dataReceived, var(readBuffer, numBytes));
+				continue;
 			}
-			break;
 
-			case SerialDevice::PortMode::DATA255:
+			if (port->mode == SerialDevice::PortMode::COBS)
 			{
-				while (port->port->available())
+				cobsDecoder.process(readBuffer, numBytes, [this](const uint8 * data, size_t size)
 				{
-					uint8_t b = port->port->read(1)[0];
-					if (b == 255)
-					{
-						serialThreadListeners.call(&SerialThreadListener::dataReceived, var(byteBuffer.data(),byteBuffer.size()));
-						byteBuffer.clear();
-					}
-					else
-					{
-						byteBuffer.push_back(b);
-					}
-				}
+					serialThreadListeners.call(&SerialThreadListener::dataReceived, var(data, size));
+				});
+				continue;
 			}
-			break;
 
-			case SerialDevice::PortMode::COBS:
-			{
-				while (port->port->available())
-				{
-					uint8_t b = port->port->read(1)[0];
-					byteBuffer.push_back(b);
-					if (b == 0)
-					{
-						uint8_t decodedData[255];
-						size_t numDecoded = cobs_decode(byteBuffer.data(), byteBuffer.size(), decodedData); 
-						serialThreadListeners.call(&SerialThreadListener::dataReceived, var(decodedData, numDecoded));
-						byteBuffer.clear();
-					}
-				}				
-			}
-			break;
-			}
+			pending.insert(pending.end(), readBuffer, readBuffer + numBytes);
+			processBytes(pending, numScanned);
 		}
 		catch (...)
 		{
 			DBG("### Serial Problem ");
+			sleep(readTimeoutMs); //don't spin if the port keeps failing
 		}
-
-		
 	}
 
 	DBG("END SERIAL THREAD");
@@ -295,6 +270,41 @@ void SerialReadThread::run()
 
 }
 
+void SerialReadThread::processBytes(std::vector<uint8_t> &pending, size_t &numScanned)
+{
+#if SERIALSUPPORT
+	//complete lines and frames are dispatched straight from the pending bytes, which are compacted once per read
+	const bool isLines = port->mode == SerialDevice::PortMode::LINES;
+	const int delimiter = isLines ? '\n' : 255;
+
+	size_t start = 0;
+	size_t searchFrom = numScanned;
+	while (searchFrom < pending.size())
+	{
+		const uint8_t * found = (const uint8_t *)memchr(pending.data() + searchFrom, delimiter, pending.size() - searchFrom);
+		if (found == nullptr) break;
+
+		size_t i = (size_t)(found - pending.data());
+		if (isLines) serialThreadListeners.call(&SerialThreadListener::dataReceived, var(std::string((const char *)pending.data() + start, i + 1 - start)));
+		else serialThreadListeners.call(&SerialThreadListener::dataReceived, var(pending.data() + start, i - start));
+
+		start = i + 1;
+		searchFrom = start;
+	}
+
+	if (start > 0) pending.erase(pending.begin(), pending.begin() + start);
+	numScanned = pending.size();
+
+	if (pending.size() > maxPendingBytes)
+	{
+		//no delimiter in sight, don't grow forever
+		if(port->mode == SerialDevice::PortMode::LINES) serialThreadListeners.call(&SerialThreadListener::dataReceived, var(std::string((const char *)pending.data(), pending.size())));
+		pending.clear();
+		numScanned = 0;
+	}
+#endif
+}
+
 SerialDeviceInfo::SerialDeviceInfo(String _port, String _description, String _hardwareID) :
 	port(_port), description(_description), hardwareID(_hardwareID)
 {
@@ -20,6 +20,7 @@ using namespace serial;
 #endif
 
 #include "lib/cobs/cobs.h"
+#include "COBSFrameDecoder.h"
 
 #include "JuceHeader.h"
 
@@ -35,7 +36,13 @@ public:
 
 	SerialDevice * port;
 
+	static const int readTimeoutMs = 20; //longest wait for data before checking if the thread should exit
+	static const size_t maxPendingBytes = 1 << 20; //a frame or line longer than this is flushed as is
+
+	COBSFrameDecoder cobsDecoder;
+
 	virtual void run() override;
+	void processBytes(std::vector<uint8_t> &pending, size_t &numScanned);
 
 
 	class SerialThreadListener {
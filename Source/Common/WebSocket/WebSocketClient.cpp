@@ -0,0 +1,170 @@
+/*
+  ==============================================================================
+
+    WebSocketClient.cpp
+    Created: 18 Oct 2026 12:21:44am
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "WebSocketClient.h"
+
+WebSocketClient::WebSocketClient(const String & name) :
+	Thread(name + " WebSocket"),
+	port(0),
+	connected(false)
+{
+}
+
+WebSocketClient::~WebSocketClient()
+{
+	stop();
+}
+
+void WebSocketClient::start(const String & _host, int _port, const String & _path)
+{
+	stop();
+
+	host = _host;
+	port = _port;
+	path = _path.startsWithChar('/') ? _path : "/" + _path;
+
+	startThread();
+}
+
+void WebSocketClient::stop()
+{
+	signalThreadShouldExit();
+	notify();
+	stopThread(2000);
+}
+
+bool WebSocketClient::send(const String & message)
+{
+	return sendFrame(WebSocketFrame::TEXT, message.toRawUTF8(), message.getNumBytesAsUTF8());
+}
+
+bool WebSocketClient::send(const MemoryBlock & data)
+{
+	return sendFrame(WebSocketFrame::BINARY, data.getData(), data.getSize());
+}
+
+bool WebSocketClient::sendFrame(int opcode, const void * data, size_t size)
+{
+	if (!connected) return false;
+
+	MemoryBlock frame = WebSocketFrame::encode(opcode, data, size, true);
+
+	const ScopedLock lock(socketLock);
+	if (socket == nullptr) return false;
+	return socket->write(frame.getData(), (int)frame.getSize()) == (int)frame.getSize();
+}
+
+bool WebSocketClient::openConnection()
+{
+	std::unique_ptr<StreamingSocket> s(new StreamingSocket());
+	if (!s->connect(host, port, 2000)) return false;
+
+	uint8 keyData[16];
+	Random::getSystemRandom().fillBitsRandomly(keyData, 16);
+	String key = Base64::toBase64(keyData, 16);
+
+	String request = "GET " + path + " HTTP/1.1\r\n"
+		+ "Host: " + host + ":" + String(port) + "\r\n"
+		+ "Upgrade: websocket\r\n"
+		+ "Connection: Upgrade\r\n"
+		+ "Sec-WebSocket-Key: " + key + "\r\n"
+		+ "Sec-WebSocket-Version: 13\r\n\r\n";
+
+	if (s->write(request.toRawUTF8(), (int)request.getNumBytesAsUTF8()) < 0) return false;
+
+	//read the response header byte by byte, so no frame data is consumed
+	MemoryOutputStream response;
+	while (!response.toString().endsWith("\r\n\r\n"))
+	{
+		char c;
+		if (response.getDataSize() > 8192 || !WebSocketFrame::readFully(*s, &c, 1, this)) return false;
+		response.writeByte(c);
+	}
+
+	StringArray lines = StringArray::fromLines(response.toString());
+	if (!lines[0].contains(" 101")) return false;
+
+	//the server must prove it read our handshake, otherwise it's not a WebSocket server (or a cached response)
+	String accept;
+	for (int i = 1; i < lines.size(); i++)
+	{
+		if (lines[i].upToFirstOccurrenceOf(":", false, false).trim().equalsIgnoreCase("Sec-WebSocket-Accept")) accept = lines[i].fromFirstOccurrenceOf(":", false, false).trim();
+	}
+
+	if (accept != WebSocketFrame::getAcceptKey(key)) return false;
+
+	const ScopedLock lock(socketLock);
+	socket = std::move(s);
+	return true;
+}
+
+void WebSocketClient::run()
+{
+	while (!threadShouldExit())
+	{
+		if (!openConnection())
+		{
+			wait(2000);
+			continue;
+		}
+
+		connected = true;
+		listeners.call(&Listener::connectionOpened);
+
+		MemoryBlock message;
+		int messageOpcode = 0;
+
+		while (!threadShouldExit())
+		{
+			int opcode = 0;
+			bool isFinal = false;
+			MemoryBlock payload;
+			if (!WebSocketFrame::read(*socket, opcode, isFinal, payload, this)) break;
+
+			if (opcode == WebSocketFrame::PING)
+			{
+				sendFrame(WebSocketFrame::PONG, payload.getData(), payload.getSize());
+				continue;
+			}
+			else if (opcode == WebSocketFrame::CLOSE)
+			{
+				sendFrame(WebSocketFrame::CLOSE, payload.getData(), payload.getSize());
+				break;
+			}
+			else if (opcode == WebSocketFrame::TEXT || opcode == WebSocketFrame::BINARY)
+			{
+				messageOpcode = opcode;
+				message = payload;
+			}
+			else if (opcode == WebSocketFrame::CONTINUATION)
+			{
+				if (messageOpcode == 0) continue;
+				message.append(payload.getData(), payload.getSize());
+			}
+			else continue;
+
+			if (!isFinal) continue;
+
+			if (messageOpcode == WebSocketFrame::TEXT) listeners.call(&Listener::messageReceived, message.toString());
+			else listeners.call(&Listener::dataReceived, message);
+			messageOpcode = 0;
+		}
+
+		connected = false;
+		{
+			const ScopedLock lock(socketLock);
+			socket->close();
+			socket.reset();
+		}
+		listeners.call(&Listener::connectionClosed);
+
+		wait(1000);
+	}
+}
@@ -0,0 +1,63 @@
+/*
+  ==============================================================================
+
+    WebSocketClient.h
+    Created: 18 Oct 2026 12:21:44am
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "WebSocketFrame.h"
+
+/*
+	Minimal WebSocket client running on its own thread. The connection is retried until stop() is called.
+	Listeners are called from the client thread.
+*/
+class WebSocketClient :
+	public Thread
+{
+public:
+	WebSocketClient(const String &name);
+	~WebSocketClient();
+
+	class Listener
+	{
+	public:
+		virtual ~Listener() {}
+		virtual void connectionOpened() {}
+		virtual void connectionClosed() {}
+		virtual void messageReceived(const String &/*message*/) {}
+		virtual void dataReceived(const MemoryBlock &/*data*/) {}
+	};
+
+	ListenerList<Listener> listeners;
+	void addWebSocketListener(Listener * l) { listeners.add(l); }
+	void removeWebSocketListener(Listener * l) { listeners.remove(l); }
+
+	void start(const String &host, int port, const String &path = "/");
+	void stop();
+
+	bool isConnected() const { return connected; }
+	String getHost() const { return host; }
+	int getPort() const { return port; }
+
+	bool send(const String &message);
+	bool send(const MemoryBlock &data);
+
+	void run() override;
+
+private:
+	String host;
+	int port;
+	String path;
+
+	CriticalSection socketLock; //the socket is replaced by the client thread while other threads may send
+	std::unique_ptr<StreamingSocket> socket;
+	std::atomic<bool> connected;
+
+	bool openConnection();
+	bool sendFrame(int opcode, const void * data, size_t size);
+};
@@ -0,0 +1,161 @@
+/*
+  ==============================================================================
+
+    WebSocketFrame.cpp
+    Created: 18 Oct 2026 12:21:44am
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "WebSocketFrame.h"
+
+MemoryBlock WebSocketFrame::encode(int opcode, const void * data, size_t size, bool masked)
+{
+	MemoryOutputStream os(size + 14);
+	os.writeByte((char)(0x80 | (opcode & 0x0F)));
+
+	const uint8 maskBit = masked ? 0x80 : 0;
+	if (size < 126) os.writeByte((char)(maskBit | size));
+	else if (size < 65536)
+	{
+		os.writeByte((char)(maskBit | 126));
+		os.writeShortBigEndian((short)size);
+	}
+	else
+	{
+		os.writeByte((char)(maskBit | 127));
+		os.writeInt64BigEndian((int64)size);
+	}
+
+	if (!masked)
+	{
+		os.write(data, size);
+		return os.getMemoryBlock();
+	}
+
+	uint8 mask[4];
+	Random::getSystemRandom().fillBitsRandomly(mask, 4);
+	os.write(mask, 4);
+
+	MemoryBlock result = os.getMemoryBlock();
+	size_t start = result.getSize();
+	result.setSize(start + size);
+	const uint8 * src = (const uint8 *)data;
+	uint8 * dest = (uint8 *)result.getData() + start;
+	for (size_t i = 0; i < size; i++) dest[i] = src[i] ^ mask[i % 4];
+
+	return result;
+}
+
+bool WebSocketFrame::read(StreamingSocket & socket, int & opcode, bool & isFinal, MemoryBlock & payload, Thread * thread)
+{
+	uint8 header[2];
+	if (!readFully(socket, header, 2, thread)) return false;
+
+	isFinal = (header[0] & 0x80) != 0;
+	opcode = header[0] & 0x0F;
+	const bool masked = (header[1] & 0x80) != 0;
+
+	int64 size = header[1] & 0x7F;
+	if (size == 126)
+	{
+		uint8 ext[2];
+		if (!readFully(socket, ext, 2, thread)) return false;
+		size = ByteOrder::bigEndianShort(ext) & 0xFFFF;
+	}
+	else if (size == 127)
+	{
+		uint8 ext[8];
+		if (!readFully(socket, ext, 8, thread)) return false;
+		size = (int64)ByteOrder::bigEndianInt64(ext);
+	}
+
+	if (size < 0 || size > maxPayloadSize) return false;
+
+	uint8 mask[4];
+	if (masked && !readFully(socket, mask, 4, thread)) return false;
+
+	payload.setSize((size_t)size);
+	if (size > 0 && !readFully(socket, payload.getData(), (int)size, thread)) return false;
+
+	if (masked)
+	{
+		uint8 * d = (uint8 *)payload.getData();
+		for (int64 i = 0; i < size; i++) d[i] ^= mask[i % 4];
+	}
+
+	return true;
+}
+
+bool WebSocketFrame::readFully(StreamingSocket & socket, void * dest, int size, Thread * thread)
+{
+	char * d = (char *)dest;
+	int numRead = 0;
+	while (numRead < size)
+	{
+		if (thread != nullptr && thread->threadShouldExit()) return false;
+
+		int ready = socket.waitUntilReady(true, 100);
+		if (ready < 0) return false;
+		if (ready == 0) continue;
+
+		int r = socket.read(d + numRead, size - numRead, false);
+		if (r <= 0) return false;
+		numRead += r;
+	}
+
+	return true;
+}
+
+String WebSocketFrame::getAcceptKey(const String & clientKey)
+{
+	String s = clientKey.trim() + "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+	uint8 hash[20];
+	sha1(s.toRawUTF8(), s.getNumBytesAsUTF8(), hash);
+	return Base64::toBase64(hash, 20);
+}
+
+void WebSocketFrame::sha1(const void * data, size_t size, uint8 result[20])
+{
+	auto rotateLeft = [](uint32 v, int bits) { return (v << bits) | (v >> (32 - bits)); };
+
+	uint32 h[5] = { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0 };
+
+	//padding : 0x80, zeros up to 56 bytes modulo 64, then the message size in bits
+	MemoryBlock m(data, size);
+	m.append("\x80", 1);
+	while (m.getSize() % 64 != 56) m.append("\0", 1);
+	uint8 sizeBits[8];
+	for (int i = 0; i < 8; i++) sizeBits[i] = (uint8)(((uint64)size * 8) >> (56 - i * 8));
+	m.append(sizeBits, 8);
+
+	const uint8 * bytes = (const uint8 *)m.getData();
+	for (size_t chunk = 0; chunk < m.getSize(); chunk += 64)
+	{
+		uint32 w[80];
+		for (int i = 0; i < 16; i++) w[i] = ByteOrder::bigEndianInt(bytes + chunk + i * 4);
+		for (int i = 16; i < 80; i++) w[i] = rotateLeft(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+
+		uint32 a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+		for (int i = 0; i < 80; i++)
+		{
+			uint32 f, k;
+			if (i < 20) { f = (b & c) | (~b & d); k = 0x5A827999; }
+			else if (i < 40) { f = b ^ c ^ d; k = 0x6ED9EBA1; }
+			else if (i < 60) { f = (b & c) | (b & d) | (c & d); k = 0x8F1BBCDC; }
+			else { f = b ^ c ^ d; k = 0xCA62C1D6; }
+
+			uint32 temp = rotateLeft(a, 5) + f + e + k + w[i];
+			e = d;
+			d = c;
+			c = rotateLeft(b, 30);
+			b = a;
+			a = temp;
+		}
+
+		h[0] += a; h[1] += b; h[2] += c; h[3] += d; h[4] += e;
+	}
+
+	for (int i = 0; i < 5; i++) ByteOrder::writeBigEndianInt(result + i * 4, h[i]);
+}
@@ -0,0 +1,35 @@
+/*
+  ==============================================================================
+
+    WebSocketFrame.h
+    Created: 18 Oct 2026 12:21:44am
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "JuceHeader.h"
+
+/*
+	WebSocket frame encoding and decoding (RFC 6455), shared by the client and the server.
+	Frames sent by a client must be masked, frames sent by a server must not.
+*/
+class WebSocketFrame
+{
+public:
+	enum Opcode { CONTINUATION = 0x0, TEXT = 0x1, BINARY = 0x2, CLOSE = 0x8, PING = 0x9, PONG = 0xA };
+
+	static const int64 maxPayloadSize = 64 * 1024 * 1024;
+
+	static MemoryBlock encode(int opcode, const void * data, size_t size, bool masked);
+
+	//blocks until a whole frame is read. Returns false if the connection is closed, the frame is invalid or the thread should exit
+	static bool read(StreamingSocket &socket, int &opcode, bool &isFinal, MemoryBlock &payload, Thread * thread);
+	static bool readFully(StreamingSocket &socket, void * dest, int size, Thread * thread);
+
+	//Sec-WebSocket-Accept value a server answers to the client's Sec-WebSocket-Key
+	static String getAcceptKey(const String &clientKey);
+	static void sha1(const void * data, size_t size, uint8 result[20]);
+};
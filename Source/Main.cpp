@@ -1,22 +1,52 @@
 #include "Main.h"
+#include "Module/ModuleManager.h"
+#include "Module/modules/osc/OSCModule.h"
+#include "Common/Engine/EngineClock.h"
+#include "Common/OSCQuery/OSCQueryServer.h"
 
 #if JUCE_MAC //for chmod
 #include <sys/types.h>
 #include <sys/stat.h>
 #endif
 
+#include <iostream>
+
 //==============================================================================
 
 ChataigneApplication::ChataigneApplication() :
-	OrganicApplication("Chataigne")
+	OrganicApplication("Chataigne"),
+	isHeadless(isHeadlessCommandLine(getCommandLineParameters()))
 {
 	enableSendAnalytics = appSettings.addBoolParameter("Send Analytics", "This helps me improve the software by sending basic start/stop/crash infos", true);
 }
 
+bool ChataigneApplication::isHeadlessCommandLine(const String& commandLine)
+{
+	return StringArray::fromTokens(commandLine, true).contains("--headless");
+}
+
+String ChataigneApplication::getCommandLineOption(const String& commandLine, const String& option)
+{
+	StringArray args = StringArray::fromTokens(commandLine, true);
+	for (auto& a : args)
+	{
+		if (a.startsWith(option + "=")) return a.fromFirstOccurrenceOf("=", false, false).unquoted();
+	}
+
+	return String();
+}
+
+void ChataigneApplication::initialise(const String& commandLine)
+{
+	if (isHeadless) initialiseHeadless(commandLine);
+	else OrganicApplication::initialise(commandLine);
+}
 
 void ChataigneApplication::initialiseInternal(const String &)
 {
 	engine.reset(new ChataigneEngine());
+	if (isHeadless) return;
+
 	mainComponent.reset(new MainContentComponent());
 
 	//Call after engine init
@@ -30,6 +60,153 @@ void ChataigneApplication::initialiseInternal(const String &)
 }
 
 
+void ChataigneApplication::initialiseHeadless(const String& commandLine)
+{
+	//Usage : Chataigne --headless [--log=file.log] [settings] [--replay=capture.oscrec [--replay-module=name] [--replay-speed=1]] show.noisette
+	//        Chataigne --headless [--log=file.log] [settings] --bench=name[,name..] [--bench-option=value..]
+	//Settings : [--tick-rate=50] [--mapping-rate=30] [--engine-thread] [--oscquery-port=port]
+	String logPath = getCommandLineOption(commandLine, "--log");
+	if (logPath.isNotEmpty()) headlessLogger.reset(new FileLogger(File::getCurrentWorkingDirectory().getChildFile(logPath), "Chataigne " + getApplicationVersion() + " (headless)", 0));
+	else headlessLogger.reset(new HeadlessLogger());
+	Logger::setCurrentLogger(headlessLogger.get());
+
+	initialiseInternal(commandLine);
+	applyHeadlessSettings(commandLine);
+
+	if (getCommandLineOption(commandLine, "--bench").isNotEmpty())
+	{
+		startHeadlessBenchmark(commandLine);
+		return;
+	}
+
+	File showFile;
+	StringArray args = StringArray::fromTokens(commandLine, true);
+	for (auto& a : args)
+	{
+		String arg = a.unquoted();
+		if (arg.startsWith("-")) continue;
+
+		File f = File::getCurrentWorkingDirectory().getChildFile(arg);
+		if (f.existsAsFile() && f.hasFileExtension(".noisette"))
+		{
+			showFile = f;
+			break;
+		}
+	}
+
+	if (!showFile.existsAsFile())
+	{
+		LOGERROR("Headless mode needs a .noisette file to run, e.g. Chataigne --headless myShow.noisette");
+		setApplicationReturnValue(1);
+		quit();
+		return;
+	}
+
+	LOG("Running " << showFile.getFullPathName() << " in headless mode");
+	Result r = engine->loadFrom(showFile, false);
+	if (r.failed())
+	{
+		LOGERROR("Could not load " << showFile.getFullPathName() << " : " << r.getErrorMessage());
+		setApplicationReturnValue(1);
+		quit();
+		return;
+	}
+
+	afterInit();
+
+	if (getCommandLineOption(commandLine, "--replay").isNotEmpty()) startHeadlessReplay(commandLine);
+}
+
+void ChataigneApplication::applyHeadlessSettings(const String& commandLine)
+{
+	//Headless mode skips OrganicApplication::initialise and the global settings it loads, the settings headless runs need are given on the command line
+	String tickRate = getCommandLineOption(commandLine, "--tick-rate");
+	if (tickRate.isNotEmpty()) EngineClock::getInstance()->tickRate->setValue(tickRate.getIntValue());
+
+	String mappingRate = getCommandLineOption(commandLine, "--mapping-rate");
+	if (mappingRate.isNotEmpty()) EngineClock::getInstance()->continuousMappingRate->setValue(mappingRate.getIntValue());
+
+	if (StringArray::fromTokens(commandLine, true).contains("--engine-thread")) EngineClock::getInstance()->useEngineThread->setValue(true);
+
+	String oscQueryPort = getCommandLineOption(commandLine, "--oscquery-port");
+	if (oscQueryPort.isNotEmpty())
+	{
+		OSCQueryServer::getInstance()->port->setValue(oscQueryPort.getIntValue());
+		OSCQueryServer::getInstance()->enableServer->setValue(true);
+	}
+
+	LOG("Engine clock at " << EngineClock::getInstance()->tickRate->intValue() << " Hz, continuous mappings at " << EngineClock::getInstance()->continuousMappingRate->intValue() << " Hz"
+		<< (EngineClock::getInstance()->useEngineThread->boolValue() ? ", on the engine thread" : String())
+		<< (OSCQueryServer::getInstance()->enableServer->boolValue() ? ", OSCQuery server on port " + OSCQueryServer::getInstance()->port->stringValue() : String()));
+}
+
+void ChataigneApplication::startHeadlessReplay(const String& commandLine)
+{
+	//Replays an OSC capture into a module of the loaded show, logs the throughput and latency report and quits
+	String moduleName = getCommandLineOption(commandLine, "--replay-module");
+
+	OSCModule* oscModule = nullptr;
+	if (moduleName.isNotEmpty()) oscModule = dynamic_cast<OSCModule*>(ModuleManager::getInstance()->getItemWithName(moduleName, true));
+	else
+	{
+		for (auto& m : ModuleManager::getInstance()->items)
+		{
+			oscModule = dynamic_cast<OSCModule*>(m);
+			if (oscModule != nullptr && oscModule->recorder != nullptr) break;
+		}
+	}
+
+	if (oscModule == nullptr || oscModule->recorder == nullptr)
+	{
+		LOGERROR("Could not find an OSC module with input to replay into" << (moduleName.isNotEmpty() ? " named " + moduleName : String()));
+		setApplicationReturnValue(1);
+		quit();
+		return;
+	}
+
+	OSCTrafficRecorder* recorder = oscModule->recorder.get();
+	recorder->captureFile->setValue(File::getCurrentWorkingDirectory().getChildFile(getCommandLineOption(commandLine, "--replay")).getFullPathName());
+
+	String speed = getCommandLineOption(commandLine, "--replay-speed");
+	if (speed.isNotEmpty()) recorder->replaySpeed->setValue(speed.getFloatValue());
+
+	recorder->onReplayFinished = [this](bool success, const String&)
+	{
+		MessageManager::callAsync([this, success]()
+		{
+			if (!success) setApplicationReturnValue(1);
+			quit();
+		});
+	};
+
+	recorder->startReplay();
+}
+
+void ChataigneApplication::startHeadlessBenchmark(const String& commandLine)
+{
+	//Runs the benchmarks without a show, logs their results and quits
+	StringArray names = StringArray::fromTokens(getCommandLineOption(commandLine, "--bench"), ",", "");
+	names.trim();
+	names.removeEmptyStrings();
+
+	StringPairArray options;
+	for (auto& a : StringArray::fromTokens(commandLine, true))
+	{
+		if (a.startsWith("--bench-")) options.set(a.fromFirstOccurrenceOf("--bench-", false, false).upToFirstOccurrenceOf("=", false, false), a.fromFirstOccurrenceOf("=", false, false).unquoted());
+	}
+
+	benchmark.reset(new HeadlessBenchmark(names, options, [this](bool success)
+	{
+		MessageManager::callAsync([this, success]()
+		{
+			if (!success) setApplicationReturnValue(1);
+			quit();
+		});
+	}));
+
+	benchmark->startThread();
+}
+
 void ChataigneApplication::afterInit()
 {
 	//ANALYTICS
@@ -47,9 +224,25 @@ void ChataigneApplication::afterInit()
 
 }
 
+bool ChataigneApplication::moreThanOneInstanceAllowed()
+{
+	//Several headless shows can run side by side on the same machine
+	return isHeadless || OrganicApplication::moreThanOneInstanceAllowed();
+}
+
 void ChataigneApplication::shutdown()
 {   
-	OrganicApplication::shutdown();
+	if (isHeadless)
+	{
+		benchmark.reset();
+		engine.reset();
+		Logger::setCurrentLogger(nullptr);
+		headlessLogger.reset();
+	}
+	else
+	{
+		OrganicApplication::shutdown();
+	}
 
 	if (enableSendAnalytics->boolValue())
 	{
@@ -59,3 +252,15 @@ void ChataigneApplication::shutdown()
 	if(MatomoAnalytics::getInstanceWithoutCreating() != nullptr) MatomoAnalytics::deleteInstance();
 	AppUpdater::deleteInstance();
 }
+
+void ChataigneApplication::systemRequestedQuit()
+{
+	//No window to ask for saving in headless mode
+	if (isHeadless) quit();
+	else OrganicApplication::systemRequestedQuit();
+}
+
+void HeadlessLogger::logMessage(const String& message)
+{
+	std::cout << message << std::endl;
+}
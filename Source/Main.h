@@ -14,6 +14,7 @@
 #include "MainComponent.h"
 #include "ChataigneEngine.h"
 #include "Analytics/MatomoAnalytics.h"
+#include "Common/Benchmark/HeadlessBenchmark.h"
 
 //==============================================================================
 class ChataigneApplication : public OrganicApplication
@@ -26,10 +27,36 @@ public:
 	BoolParameter * enableSendAnalytics;
 	//
 
+	//Headless mode : only the engine is created, no window, no layout, no UI timers
+	bool isHeadless;
+	std::unique_ptr<Logger> headlessLogger;
+	std::unique_ptr<HeadlessBenchmark> benchmark;
+
+	static bool isHeadlessCommandLine(const String& commandLine);
+	static String getCommandLineOption(const String& commandLine, const String& option);
+
+	void initialise(const String& commandLine) override;
 	void initialiseInternal(const String& /*commandLine*/) override;
+	void initialiseHeadless(const String& commandLine);
+	void applyHeadlessSettings(const String& commandLine);
+	void startHeadlessReplay(const String& commandLine);
+	void startHeadlessBenchmark(const String& commandLine);
 	void afterInit() override;
 
+	bool moreThanOneInstanceAllowed() override;
+
 	void shutdown() override;
+	void systemRequestedQuit() override;
+};
+
+class HeadlessLogger :
+	public Logger
+{
+public:
+	HeadlessLogger() {}
+	~HeadlessLogger() {}
+
+	void logMessage(const String& message) override;
 };
 
 START_JUCE_APPLICATION(ChataigneApplication)
\ No newline at end of file
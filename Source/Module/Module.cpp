@@ -29,7 +29,11 @@ Module::Module(const String& name) :
 	alwaysShowValues(false),
 	includeValuesInSave(false),
 	customType(""),
-    canHandleRouteValues(false)
+    canHandleRouteValues(false),
+	conflateInput(nullptr),
+	appliedUpdates(nullptr),
+	conflatedUpdates(nullptr),
+	inputFlushPending(false)
 
 {
 	itemDataType = "Module";
@@ -74,10 +78,13 @@ Module::Module(const String& name) :
 	scriptManager->scriptTemplate = ChataigneAssetManager::getInstance()->getScriptTemplateBundle(StringArray("generic","module"));
 
 	scriptCommanDef.reset(CommandDefinition::createDef(this, "", "Script callback", &ScriptCallbackCommand::create));
+
+	inputQueue = EngineThread::getInstance()->createInputQueue(name);
 }
 
 Module::~Module()
 {
+	if (EngineThread::getInstanceWithoutCreating() != nullptr) EngineThread::getInstance()->closeInputQueue(inputQueue.get());
 }
 
 void Module::setupIOConfiguration(bool _hasInput, bool _hasOutput)
@@ -91,6 +98,23 @@ void Module::setupIOConfiguration(bool _hasInput, bool _hasOutput)
 	moduleListeners.call(&ModuleListener::moduleIOConfigurationChanged);
 }
 
+void Module::postInput(EngineInputQueue::InputFunction inputFunc)
+{
+	EngineThread* et = EngineThread::getInstanceWithoutCreating();
+	
+	//When conflating, data is parsed on the receiving thread and only the resolved values are handed over through setInputValue
+	if (et == nullptr || !et->isThreadRunning() || !inputQueue->isOpen || isInputConflated())
+	{
+		inputFunc();
+		return;
+	}
+
+	if (!et->postInput(inputQueue.get(), inputFunc))
+	{
+		if (logIncomingData->boolValue()) NLOGWARNING(niceName, "Engine input queue is full, dropping incoming data");
+	}
+}
+
 String Module::getHelpID()
 {
 	return getTypeString();
@@ -162,6 +186,66 @@ void Module::onControllableFeedbackUpdateInternal(ControllableContainer * cc, Co
 	if(c->type != Controllable::TRIGGER) processDependencies((Parameter *)c);
 }
 
+void Module::setupInputConflation()
+{
+	if (conflateInput != nullptr) return;
+
+	conflateInput = moduleParams.addBoolParameter("Conflate Values", "When the engine thread is enabled, only the latest value of each parameter received between two engine updates is applied. Triggers are never merged.", true);
+
+	appliedUpdates = moduleParams.addIntParameter("Applied Updates", "Number of incoming value updates applied by the engine thread", 0, 0);
+	appliedUpdates->setControllableFeedbackOnly(true);
+	appliedUpdates->isSavable = false;
+
+	conflatedUpdates = moduleParams.addIntParameter("Conflated Updates", "Number of incoming value updates that were replaced by a newer one before being applied", 0, 0);
+	conflatedUpdates->setControllableFeedbackOnly(true);
+	conflatedUpdates->isSavable = false;
+}
+
+bool Module::isInputConflated()
+{
+	if (conflateInput == nullptr || !conflateInput->boolValue()) return false;
+	EngineThread* et = EngineThread::getInstanceWithoutCreating();
+	return et != nullptr && et->isThreadRunning() && inputQueue->isOpen;
+}
+
+void Module::setInputValue(Controllable* c, const var& value)
+{
+	if (c == nullptr) return;
+
+	if (!isInputConflated())
+	{
+		ConflatingValueQueue::applyValue(c, value);
+		return;
+	}
+
+	inputValueQueue.push(c, value);
+
+	//Only one flush is scheduled at a time, every value pushed before it runs is applied by it
+	if (inputFlushPending.exchange(true)) return;
+	if (!EngineThread::getInstance()->postInput(inputQueue.get(), [this]() { flushInputValues(); }))
+	{
+		inputFlushPending = false;
+		if (logIncomingData->boolValue()) NLOGWARNING(niceName, "Engine input queue is full, values will be applied with the next update");
+	}
+}
+
+void Module::flushInputValues()
+{
+	inputFlushPending = false;
+	inputValueQueue.flush();
+
+	if (appliedUpdates != nullptr) appliedUpdates->setValue(inputValueQueue.numApplied.load());
+	if (conflatedUpdates != nullptr) conflatedUpdates->setValue(inputValueQueue.numConflated.load());
+}
+
+void Module::clearItem()
+{
+	//Wait for the engine thread to be done with this module's input before anything gets deleted
+	if (EngineThread::getInstanceWithoutCreating() != nullptr) EngineThread::getInstance()->closeInputQueue(inputQueue.get());
+	inputValueQueue.clear();
+	BaseItem::clearItem();
+}
+
 var Module::getJSONData()
 {
 	var data = BaseItem::getJSONData();
@@ -13,6 +13,8 @@
 #include "JuceHeader.h"
 #include "Common/Command/CommandContext.h"
 #include  "Common/Command/CommandDefinitionManager.h"
+#include "Common/Engine/EngineThread.h"
+#include "Common/Engine/ConflatingValueQueue.h"
 
 class ModuleCommandTester;
 class BaseCommandHandler;
@@ -60,6 +62,22 @@ public:
 	//ROUTING
 	bool canHandleRouteValues;
 
+	//ENGINE THREAD
+	EngineInputQueue::Ptr inputQueue;
+	void postInput(EngineInputQueue::InputFunction inputFunc); //process incoming data on the engine thread if enabled, or directly otherwise
+
+	//INPUT CONFLATION
+	BoolParameter * conflateInput;
+	IntParameter * appliedUpdates;
+	IntParameter * conflatedUpdates;
+	ConflatingValueQueue inputValueQueue;
+	std::atomic<bool> inputFlushPending;
+
+	void setupInputConflation(); //modules that resolve their values on the receiving thread call this to expose the conflation option
+	bool isInputConflated();
+	void setInputValue(Controllable * c, const var &value); //apply an incoming value, or hand it over to the engine thread keeping only the latest value of each parameter
+	void flushInputValues();
+
 	//help
     virtual String getHelpID() override;
 
@@ -111,6 +129,8 @@ public:
 
 	virtual void onControllableFeedbackUpdateInternal(ControllableContainer * cc, Controllable * c) override;
 	
+	virtual void clearItem() override;
+
 	var getJSONData() override;
 	void loadJSONDataItemInternal(var data) override;
 
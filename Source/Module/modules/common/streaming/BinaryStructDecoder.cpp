@@ -0,0 +1,305 @@
+/*
+  ==============================================================================
+
+    BinaryStructDecoder.cpp
+    Created: 18 Oct 2026 4:02:37am
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "BinaryStructDecoder.h"
+
+BinaryStructDecoder::BinaryStructDecoder() :
+	numValues(0),
+	minSize(0),
+	checksumType(NO_CHECKSUM),
+	checksumBigEndian(false),
+	checksumOffset(0),
+	checksumStart(0)
+{
+}
+
+int BinaryStructDecoder::Field::getTypeSize() const
+{
+	switch (type)
+	{
+	case UINT8: case INT8: return 1;
+	case UINT16: case INT16: return 2;
+	case UINT32: case INT32: case FLOAT32: return 4;
+	case FLOAT64: return 8;
+	}
+	return 0;
+}
+
+BinaryStructDecoder * BinaryStructDecoder::compile(const String & schema, String & error)
+{
+	std::unique_ptr<BinaryStructDecoder> decoder(new BinaryStructDecoder());
+
+	StringArray lines;
+	lines.addTokens(schema, ";\n", "");
+	lines.trim();
+	lines.removeEmptyStrings();
+
+	int nextOffset = 0;
+	for (auto &line : lines)
+	{
+		if (line.startsWith("#") || line.startsWith("//")) continue;
+
+		StringArray tokens;
+		tokens.addTokens(line, " \t", "");
+		tokens.removeEmptyStrings();
+
+		int offset = -1;
+		double scale = 1;
+		int start = 0;
+		int checksumEndianness = -1; //not specified
+		for (int i = 2; i < tokens.size(); i++)
+		{
+			const String &t = tokens[i];
+			if (t.startsWith("@"))
+			{
+				offset = t.substring(1).getIntValue();
+				if (offset < 0 || offset >= maxMessageSize || !t.substring(1).containsOnly("0123456789"))
+				{
+					error = "Invalid offset in \"" + line + "\", offsets go from 0 to " + String(maxMessageSize - 1);
+					return nullptr;
+				}
+			}
+			else if (t.startsWith("*")) scale = t.substring(1).getDoubleValue();
+			else if (t == "from" && i < tokens.size() - 1)
+			{
+				start = tokens[++i].getIntValue();
+				if (start < 0 || start >= maxMessageSize || !tokens[i].containsOnly("0123456789"))
+				{
+					error = "Invalid checksum start in \"" + line + "\"";
+					return nullptr;
+				}
+			}
+			else if (tokens[0] == "checksum" && (t == "le" || t == "be")) checksumEndianness = t == "be" ? 1 : 0;
+			else
+			{
+				error = "Unknown option \"" + t + "\" in \"" + line + "\"";
+				return nullptr;
+			}
+		}
+
+		if (tokens.size() < 2)
+		{
+			error = "Missing type in \"" + line + "\"";
+			return nullptr;
+		}
+
+		if (tokens[0] == "checksum")
+		{
+			const String algo = tokens[1].toLowerCase();
+			if (algo == "sum8") decoder->checksumType = SUM8;
+			else if (algo == "xor8") decoder->checksumType = XOR8;
+			else if (algo == "crc16") decoder->checksumType = CRC16_MODBUS;
+			else if (algo == "crc16ccitt") decoder->checksumType = CRC16_CCITT;
+			else if (algo == "crc32") decoder->checksumType = CRC32;
+			else
+			{
+				error = "Unknown checksum \"" + tokens[1] + "\"";
+				return nullptr;
+			}
+
+			//CCITT is usually sent high byte first, the others low byte first
+			decoder->checksumBigEndian = checksumEndianness == -1 ? decoder->checksumType == CRC16_CCITT : checksumEndianness == 1;
+			decoder->checksumOffset = offset >= 0 ? offset : nextOffset;
+			decoder->checksumStart = start;
+			if (decoder->checksumStart > decoder->checksumOffset)
+			{
+				error = "Checksum range starts after the checksum itself";
+				return nullptr;
+			}
+
+			nextOffset = decoder->checksumOffset + getChecksumSize(decoder->checksumType);
+			if (nextOffset > maxMessageSize)
+			{
+				error = "Checksum ends after " + String(maxMessageSize) + " bytes";
+				return nullptr;
+			}
+
+			decoder->minSize = jmax(decoder->minSize, nextOffset);
+			continue;
+		}
+
+		Field f;
+		f.name = tokens[0];
+		f.offset = offset >= 0 ? offset : nextOffset;
+		f.scale = scale;
+		f.count = 1;
+		f.valueIndex = decoder->numValues;
+
+		String type = tokens[1].toLowerCase();
+		if (type.contains("["))
+		{
+			const String count = type.fromFirstOccurrenceOf("[", false, false).upToFirstOccurrenceOf("]", false, false);
+			f.count = count.getIntValue();
+			type = type.upToFirstOccurrenceOf("[", false, false);
+			if (f.count < 1 || f.count > maxValues || !count.containsOnly("0123456789"))
+			{
+				error = "Invalid array size in \"" + line + "\", arrays have 1 to " + String(maxValues) + " items";
+				return nullptr;
+			}
+		}
+
+		f.bigEndian = type.endsWith("be");
+		if (type.endsWith("be") || type.endsWith("le")) type = type.dropLastCharacters(2);
+
+		if (type == "u8") f.type = UINT8;
+		else if (type == "i8") f.type = INT8;
+		else if (type == "u16") f.type = UINT16;
+		else if (type == "i16") f.type = INT16;
+		else if (type == "u32") f.type = UINT32;
+		else if (type == "i32") f.type = INT32;
+		else if (type == "f32" || type == "float") f.type = FLOAT32;
+		else if (type == "f64" || type == "double") f.type = FLOAT64;
+		else
+		{
+			error = "Unknown type \"" + tokens[1] + "\" for " + f.name;
+			return nullptr;
+		}
+
+		const int64 fieldEnd = (int64)f.offset + (int64)f.getTypeSize() * f.count;
+		if (fieldEnd > maxMessageSize)
+		{
+			error = f.name + " ends after " + String(maxMessageSize) + " bytes";
+			return nullptr;
+		}
+
+		if (decoder->numValues + f.count > maxValues)
+		{
+			error = "The structure has more than " + String(maxValues) + " values";
+			return nullptr;
+		}
+
+		nextOffset = (int)fieldEnd;
+		decoder->minSize = jmax(decoder->minSize, nextOffset);
+		decoder->numValues += f.count;
+		decoder->fields.add(f);
+	}
+
+	if (decoder->fields.isEmpty())
+	{
+		error = "No field defined";
+		return nullptr;
+	}
+
+	return decoder.release();
+}
+
+BinaryStructDecoder::Result BinaryStructDecoder::decode(const uint8 * data, int size, double * values) const
+{
+	if (size < minSize) return TOO_SHORT;
+
+	if (checksumType != NO_CHECKSUM)
+	{
+		uint32 expected = (uint32)readRaw(data + checksumOffset, getChecksumSize(checksumType), checksumBigEndian);
+		if (computeChecksum(checksumType, data + checksumStart, checksumOffset - checksumStart) != expected) return BAD_CHECKSUM;
+	}
+
+	for (auto &f : fields)
+	{
+		const int typeSize = f.getTypeSize();
+		for (int i = 0; i < f.count; i++)
+		{
+			uint64 raw = readRaw(data + f.offset + i * typeSize, typeSize, f.bigEndian);
+			double v = 0;
+			switch (f.type)
+			{
+			case UINT8: v = (uint8)raw; break;
+			case INT8: v = (int8)raw; break;
+			case UINT16: v = (uint16)raw; break;
+			case INT16: v = (int16)raw; break;
+			case UINT32: v = (uint32)raw; break;
+			case INT32: v = (int32)raw; break;
+			case FLOAT32: { uint32 r = (uint32)raw; float fv; memcpy(&fv, &r, 4); v = fv; } break;
+			case FLOAT64: { double dv; memcpy(&dv, &raw, 8); v = dv; } break;
+			}
+
+			values[f.valueIndex + i] = v * f.scale;
+		}
+	}
+
+	return OK;
+}
+
+uint64 BinaryStructDecoder::readRaw(const uint8 * data, int size, bool bigEndian)
+{
+	uint64 result = 0;
+	for (int i = 0; i < size; i++)
+	{
+		const uint64 b = data[bigEndian ? i : size - 1 - i];
+		result = (result << 8) | b;
+	}
+	return result;
+}
+
+uint32 BinaryStructDecoder::computeChecksum(ChecksumType type, const uint8 * data, int size)
+{
+	switch (type)
+	{
+	case SUM8:
+	{
+		uint8 sum = 0;
+		for (int i = 0; i < size; i++) sum += data[i];
+		return sum;
+	}
+
+	case XOR8:
+	{
+		uint8 x = 0;
+		for (int i = 0; i < size; i++) x ^= data[i];
+		return x;
+	}
+
+	case CRC16_MODBUS:
+	{
+		uint16 crc = 0xFFFF;
+		for (int i = 0; i < size; i++)
+		{
+			crc ^= data[i];
+			for (int b = 0; b < 8; b++) crc = (crc & 1) ? (uint16)((crc >> 1) ^ 0xA001) : (uint16)(crc >> 1);
+		}
+		return crc;
+	}
+
+	case CRC16_CCITT:
+	{
+		uint16 crc = 0xFFFF;
+		for (int i = 0; i < size; i++)
+		{
+			crc ^= (uint16)(data[i] << 8);
+			for (int b = 0; b < 8; b++) crc = (crc & 0x8000) ? (uint16)((crc << 1) ^ 0x1021) : (uint16)(crc << 1);
+		}
+		return crc;
+	}
+
+	case CRC32:
+	{
+		uint32 crc = 0xFFFFFFFF;
+		for (int i = 0; i < size; i++)
+		{
+			crc ^= data[i];
+			for (int b = 0; b < 8; b++) crc = (crc & 1) ? ((crc >> 1) ^ 0xEDB88320) : (crc >> 1);
+		}
+		return ~crc;
+	}
+
+	default:
+		return 0;
+	}
+}
+
+int BinaryStructDecoder::getChecksumSize(ChecksumType type)
+{
+	switch (type)
+	{
+	case SUM8: case XOR8: return 1;
+	case CRC16_MODBUS: case CRC16_CCITT: return 2;
+	case CRC32: return 4;
+	default: return 0;
+	}
+}
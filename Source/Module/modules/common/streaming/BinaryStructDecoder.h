@@ -0,0 +1,73 @@
+/*
+  ==============================================================================
+
+    BinaryStructDecoder.h
+    Created: 18 Oct 2026 4:02:37am
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "JuceHeader.h"
+
+/*
+	Decodes fixed layout binary messages described by a text schema, one field per line (or separated by ;) :
+
+		name type[count] @offset *scale
+
+	type is one of u8, i8, u16, i16, u32, i32, f32, f64, with an optional le / be suffix (little endian by default).
+	[count], @offset and *scale are optional : fields follow each other when no offset is given.
+	A checksum line validates the message before anything is decoded :
+
+		checksum sum8|xor8|crc16|crc16ccitt|crc32 @offset from start
+
+	The checksum is computed over the bytes from start (0 by default) up to its own offset.
+	Schemas reaching past maxMessageSize or with more than maxValues values are rejected.
+*/
+class BinaryStructDecoder
+{
+public:
+	enum FieldType { UINT8, INT8, UINT16, INT16, UINT32, INT32, FLOAT32, FLOAT64 };
+	enum ChecksumType { NO_CHECKSUM, SUM8, XOR8, CRC16_MODBUS, CRC16_CCITT, CRC32 };
+
+	struct Field
+	{
+		String name;
+		FieldType type;
+		bool bigEndian;
+		int offset;
+		int count;
+		double scale;
+		int valueIndex; //index of the first value of this field in the decoded values
+
+		int getTypeSize() const;
+		bool isInteger() const { return type != FLOAT32 && type != FLOAT64; }
+	};
+
+	static const int maxMessageSize = 65536; //fields and checksum must end within this many bytes
+	static const int maxValues = 256; //each value of the structure gets a parameter
+
+	Array<Field> fields;
+	int numValues;
+	int minSize; //messages shorter than this are rejected
+
+	ChecksumType checksumType;
+	bool checksumBigEndian;
+	int checksumOffset;
+	int checksumStart;
+
+	static BinaryStructDecoder * compile(const String &schema, String &error);
+
+	enum Result { OK, TOO_SHORT, BAD_CHECKSUM };
+	Result decode(const uint8 * data, int size, double * values) const; //values must hold numValues doubles
+
+	static uint32 computeChecksum(ChecksumType type, const uint8 * data, int size);
+	static int getChecksumSize(ChecksumType type);
+
+private:
+	BinaryStructDecoder();
+
+	static uint64 readRaw(const uint8 * data, int size, bool bigEndian);
+};
@@ -120,9 +120,7 @@ void NetworkStreamingModule::run()
 
 	initThread();
 
-	//char buffer[512];
-	String stringBuffer = ""; //for lines;
-	Array<uint8> byteBuffer; //for cobs and data255
+	StreamBuffer buffer;
 
 	while (!threadShouldExit())
 	{
@@ -133,68 +131,8 @@ void NetworkStreamingModule::run()
 			try
 			{
 				Array<uint8> bytes = readBytes();
-				int numBytes = bytes.size();
-				if (numBytes == 0) continue;
-
-				StreamingType m = streamingType->getValueDataAsEnum<StreamingType>();
-				switch (m)
-				{
-
-				case LINES:
-				{
-					if (CharPointer_UTF8::isValidString((char *)bytes.getRawDataPointer(), numBytes))
-					{
-						stringBuffer.append(String::fromUTF8((char *)bytes.getRawDataPointer(), numBytes), numBytes);
-						StringArray sa;
-						sa.addTokens(stringBuffer, "\r\n", "\"");
-						for (int i = 0; i < sa.size() - 1; i++) processDataLine(sa[i]);
-						stringBuffer = sa[sa.size() - 1];
-					}
-				}
-				break;
-
-				case RAW:
-				{
-					processDataBytes(bytes);
-				}
-				break;
-
-				case DATA255:
-				{
-					for (int i = 0; i < numBytes; i++)
-					{
-						uint8 b = bytes[i];
-						if (b == 255)
-						{
-							processDataBytes(byteBuffer);
-							byteBuffer.clear();
-						} else
-						{
-							byteBuffer.add(b);
-						}
-					}
-
-				}
-				break;
-
-				case COBS:
-				{
-					for (int i = 0; i < numBytes; i++)
-					{
-						uint8_t b = bytes[i];
-						byteBuffer.add(bytes[i]);
-
-						if (b == 0)
-						{
-							uint8_t decodedData[255];
-							size_t numDecoded = cobs_decode(byteBuffer.getRawDataPointer() , byteBuffer.size(), decodedData);
-							processDataBytes(Array<uint8>(decodedData,(int)numDecoded));
-							byteBuffer.clear();
-						}
-					}
-				}
-				break;
-				}
+				if (bytes.size() == 0) continue;
+				processReceivedBytes(buffer, bytes.getRawDataPointer(), bytes.size());
 			} catch (...)
 			{
 				DBG("### Streaming receive thread problem ");
@@ -204,3 +142,64 @@ void NetworkStreamingModule::run()
 
 	DBG("Exit thread");
 }
+
+void NetworkStreamingModule::processReceivedBytes(StreamBuffer &buffer, const uint8 * bytes, int numBytes, const String &source)
+{
+	StreamingType m = streamingType->getValueDataAsEnum<StreamingType>();
+	switch (m)
+	{
+
+	case LINES:
+	{
+		if (CharPointer_UTF8::isValidString((const char *)bytes, numBytes))
+		{
+			buffer.stringBuffer.append(String::fromUTF8((const char *)bytes, numBytes), numBytes);
+			StringArray sa;
+			sa.addTokens(buffer.stringBuffer, "\r\n", "\"");
+			for (int i = 0; i < sa.size() - 1; i++)
+			{
+				String line = sa[i];
+				postInput([this, line, source]() { if (source.isNotEmpty()) setInputSource(source); processDataLine(line); });
+			}
+			buffer.stringBuffer = sa[sa.size() - 1];
+		}
+	}
+	break;
+
+	case RAW:
+	{
+		Array<uint8> data(bytes, numBytes);
+		postInput([this, data, source]() { if (source.isNotEmpty()) setInputSource(source); processDataBytes(data); });
+	}
+	break;
+
+	case DATA255:
+	{
+		for (int i = 0; i < numBytes; i++)
+		{
+			uint8 b = bytes[i];
+			if (b == 255)
+			{
+				Array<uint8> frame = buffer.byteBuffer;
+				postInput([this, frame, source]() { if (source.isNotEmpty()) setInputSource(source); processDataBytes(frame); });
+				buffer.byteBuffer.clear();
+			} else
+			{
+				buffer.byteBuffer.add(b);
+			}
+		}
+
+	}
+	break;
+
+	case COBS:
+	{
+		buffer.cobsDecoder.process(bytes, (size_t)numBytes, [this, &source](const uint8 * data, size_t size)
+		{
+			Array<uint8> frame(data, (int)size);
+			postInput([this, frame, source]() { if (source.isNotEmpty()) setInputSource(source); processDataBytes(frame); });
+		});
+	}
+	break;
+	}
+}
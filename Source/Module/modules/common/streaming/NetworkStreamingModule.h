@@ -11,6 +11,7 @@
 #pragma once
 
 #include "StreamingModule.h"
+#include "Common/Serial/COBSFrameDecoder.h"
 
 class NetworkStreamingModule :
 	public StreamingModule,
@@ -48,6 +49,17 @@ public:
 
 	virtual void loadJSONDataInternal(var data) override;
 
+	//framing state of one incoming byte stream, so that partial messages of different streams (i.e. TCP clients) never mix
+	struct StreamBuffer
+	{
+		String stringBuffer; //for lines
+		Array<uint8> byteBuffer; //for data255
+		COBSFrameDecoder cobsDecoder;
+	};
+
+	void processReceivedBytes(StreamBuffer &buffer, const uint8 * bytes, int numBytes, const String &source = String());
+	virtual void setInputSource(const String &/*source*/) {} //called before processing data that was received from a given source
+
 	virtual void initThread() {}
 	virtual void run() override;
 	
@@ -16,7 +16,10 @@
 #include "UI/ChataigneAssetManager.h"
 
 StreamingModule::StreamingModule(const String & name) :
-	Module(name)
+	Module(name),
+	valueIndexDirty(true),
+	lastLookupMissed(false),
+	isCompilingStruct(false)
 {
 	includeValuesInSave = true;
 	setupIOConfiguration(true, true);
@@ -28,6 +31,9 @@ StreamingModule::StreamingModule(const String & name) :
 	autoAdd = moduleParams.addBoolParameter("Auto Add", "If checked, incoming data will be parsed depending on the Message Structure parameter, and if eligible will be added as values", true);
 	messageStructure = moduleParams.addEnumParameter("Message Structure", "The expected structure of a message, determining how it should be interpreted to auto create values from it");
 	firstValueIsTheName = moduleParams.addBoolParameter("First value is the name", "If checked, the first value of a parsed message will be used to name the value, otherwise each values will be named by their index", true);
+	structSchema = moduleParams.addStringParameter("Structure", "When Message Structure is Custom structure, the layout of the incoming messages, one field per line : name type[count] @offset *scale.\nTypes are u8, i8, u16, i16, u32, i32, f32, f64 with an optional le/be suffix.\nA line like \"checksum crc16 @offset from start\" validates messages (sum8, xor8, crc16, crc16ccitt, crc32).", "value u8");
+	structSchema->multiline = true;
+	structSchema->setEnabled(false);
 	buildMessageStructureOptions();
 
 	defManager->add(CommandDefinition::createDef(this, "", "Send string", &SendStreamStringCommand::create, CommandContext::BOTH));
@@ -43,6 +49,8 @@ StreamingModule::StreamingModule(const String & name) :
 
 	valuesCC.userCanAddControllables = true;
 	valuesCC.customUserCreateControllableFunc = &StreamingModule::showMenuAndCreateValue;
+
+	setupInputConflation();
 }
 
 StreamingModule::~StreamingModule()
@@ -83,7 +91,7 @@ void StreamingModule::buildMessageStructureOptions()
 	case COBS:
 	case DATA255:
 	{
-		messageStructure->addOption("1 value per byte", RAW_1BYTE)->addOption("4x4 (floats)", RAW_FLOATS)->addOption("4x4 (RGBA colors)", RAW_COLORS);
+		messageStructure->addOption("1 value per byte", RAW_1BYTE)->addOption("4x4 (floats)", RAW_FLOATS)->addOption("4x4 (RGBA colors)", RAW_COLORS)->addOption("Custom structure", RAW_STRUCT);
 	}
 	break;
 	}
@@ -95,14 +103,16 @@ void StreamingModule::processDataLine(const String & msg)
 	if (logIncomingData->boolValue()) NLOG(niceName, "Message received : " << (msg.isNotEmpty() ? msg : "(Empty message)"));
 	inActivityTrigger->trigger();
 
-	const String message = msg.removeCharacters("\r\n");
+	const String message = msg.containsAnyOf("\r\n") ? msg.removeCharacters("\r\n") : msg;
 	if (message.isEmpty()) return;
 
 	processDataLineInternal(message);
 	
-	scriptManager->callFunctionOnAllItems(dataEventId, message);
+	if (scriptManager->items.size() > 0) scriptManager->callFunctionOnAllItems(dataEventId, message);
 
 	MessageStructure s = messageStructure->getValueDataAsEnum<MessageStructure>();
+	if (processDataLineFast(message, s)) return;
+
 	StringArray valuesString;
 	String separator;
 	switch (s)
@@ -136,6 +146,7 @@ void StreamingModule::processDataLine(const String & msg)
 		int numArgs = valuesString.size() - 1;
 		
 		Controllable * c = valuesCC.getControllableByName(valueName, true);
+		if (c != nullptr && lastLookupMissed) valueIndexDirty = true; //renamed since the index was built
 
 		if (c == nullptr)
 		{
@@ -177,33 +188,33 @@ void StreamingModule::processDataLine(const String & msg)
 			switch (t)
 			{
 			case Controllable::TRIGGER:
-				((Trigger *)c)->trigger();
+				setInputValue(c, var());
 				break;
 
 			case Controllable::FLOAT:
-				if (numArgs >= 1) ((FloatParameter *)c)->setValue(valuesString[1].getFloatValue());
+				if (numArgs >= 1) setInputValue(c, valuesString[1].getFloatValue());
 				break;
 
 			case Controllable::INT:
-				if (numArgs >= 1) ((IntParameter*)c)->setValue(valuesString[1].getIntValue());
+				if (numArgs >= 1) setInputValue(c, valuesString[1].getIntValue());
 				break;
 
 			case Controllable::POINT2D:
-				if (numArgs >= 2) ((Point2DParameter *)c)->setPoint(valuesString[1].getFloatValue(), valuesString[2].getFloatValue());
+				if (numArgs >= 2) setInputValue(c, Array<var>(valuesString[1].getFloatValue(), valuesString[2].getFloatValue()));
 				break;
 
 			case Controllable::POINT3D:
-				if (numArgs >= 3) ((Point3DParameter *)c)->setVector(valuesString[1].getFloatValue(), valuesString[2].getFloatValue(), valuesString[3].getFloatValue());
+				if (numArgs >= 3) setInputValue(c, Array<var>(valuesString[1].getFloatValue(), valuesString[2].getFloatValue(), valuesString[3].getFloatValue()));
 				break; 
 
 			case Controllable::COLOR:
-				if (numArgs >= 4) ((ColorParameter *)c)->setColor(Colour::fromFloatRGBA(valuesString[1].getFloatValue(), valuesString[2].getFloatValue(), valuesString[3].getFloatValue(), valuesString[4].getFloatValue()));
+				if (numArgs >= 4) setInputValue(c, Array<var>(valuesString[1].getFloatValue(), valuesString[2].getFloatValue(), valuesString[3].getFloatValue(), valuesString[4].getFloatValue()));
 				break;
                     
 			case Controllable::STRING:
 			{
 				valuesString.remove(0);
-				if(numArgs >= 1) ((StringParameter *)c)->setValue(valuesString.joinIntoString(" "));
+				if(numArgs >= 1) setInputValue(c, valuesString.joinIntoString(" "));
 			}
 			break;
 
@@ -250,11 +261,11 @@ void StreamingModule::processDataLine(const String & msg)
 			{
 				switch (c->type)
 				{
-				case Controllable::FLOAT: ((FloatParameter*)c)->setValue(valuesString[i].getFloatValue()); break;
-				case Controllable::INT:((IntParameter*)c)->setValue(valuesString[i].getIntValue()); break;
-				case Controllable::STRING: ((StringParameter*)c)->setValue(valuesString[i]); break;
+				case Controllable::FLOAT: setInputValue(c, valuesString[i].getFloatValue()); break;
+				case Controllable::INT: setInputValue(c, valuesString[i].getIntValue()); break;
+				case Controllable::STRING: setInputValue(c, valuesString[i]); break;
 				default:
-					((Parameter*)c)->setValue(valuesString[i].getFloatValue()); break;
+					setInputValue(c, valuesString[i].getFloatValue()); break;
 					break;
 				}
 			}
@@ -262,6 +273,187 @@ void StreamingModule::processDataLine(const String & msg)
 	}
 }
 
+bool StreamingModule::processDataLineFast(const String & message, MessageStructure s)
+{
+	lastLookupMissed = false;
+
+	const char separator = getSeparatorChar(s);
+	if (separator == 0) return false;
+
+	//same tokens as StringArray::addTokens, empty ones included
+	LineToken tokens[maxFastTokens];
+	int numTokens = 0;
+	const char * start = message.toRawUTF8();
+	for (const char * p = start; ; p++)
+	{
+		if (*p == '"') return false; //quoted tokens are left to the generic parser
+		if (*p != separator && *p != 0) continue;
+
+		if (numTokens == maxFastTokens || p - start > maxFastTokenLength) return false;
+		tokens[numTokens++] = { start, (int)(p - start) };
+		if (*p == 0) break;
+		start = p + 1;
+	}
+
+	if (valueIndexDirty) rebuildValueIndex();
+
+	if (firstValueIsTheName->boolValue())
+	{
+		Controllable * c = findIndexedValue(tokens[0]);
+		if (c == nullptr)
+		{
+			lastLookupMissed = true;
+			return false;
+		}
+
+		return applyTokens(c, tokens + 1, numTokens - 1);
+	}
+
+	Controllable * targets[maxFastTokens];
+	for (int i = 0; i < numTokens; i++)
+	{
+		targets[i] = i < valuesByPosition.size() ? valuesByPosition[i].get() : nullptr;
+		if (targets[i] == nullptr || targets[i]->niceName.getTrailingIntValue() != i) return false;
+		if (targets[i]->type != Controllable::FLOAT && targets[i]->type != Controllable::INT) return false;
+	}
+
+	for (int i = 0; i < numTokens; i++) applyTokens(targets[i], tokens + i, 1);
+	return true;
+}
+
+bool StreamingModule::applyTokens(Controllable * c, const LineToken * tokens, int numArgs)
+{
+	switch (c->type)
+	{
+	case Controllable::TRIGGER:
+		setInputValue(c, var());
+		break;
+
+	case Controllable::FLOAT:
+		if (numArgs >= 1) setInputValue(c, getTokenFloat(tokens[0]));
+		break;
+
+	case Controllable::INT:
+		if (numArgs >= 1) setInputValue(c, getTokenInt(tokens[0]));
+		break;
+
+	case Controllable::POINT2D:
+		if (numArgs >= 2) setInputValue(c, Array<var>(getTokenFloat(tokens[0]), getTokenFloat(tokens[1])));
+		break;
+
+	case Controllable::POINT3D:
+		if (numArgs >= 3) setInputValue(c, Array<var>(getTokenFloat(tokens[0]), getTokenFloat(tokens[1]), getTokenFloat(tokens[2])));
+		break;
+
+	case Controllable::COLOR:
+		if (numArgs >= 4) setInputValue(c, Array<var>(getTokenFloat(tokens[0]), getTokenFloat(tokens[1]), getTokenFloat(tokens[2]), getTokenFloat(tokens[3])));
+		break;
+
+	default:
+		return false; //strings keep the generic path, they need the joined text
+	}
+
+	return true;
+}
+
+void StreamingModule::rebuildValueIndex()
+{
+	valueIndexDirty = false;
+	valueIndex.clear();
+	valueIndexEntries.clearQuick();
+	valuesByPosition.clearQuick();
+
+	for (auto &c : valuesCC.controllables)
+	{
+		addToValueIndex(c, c->shortName, false);
+		if (c->niceName != c->shortName) addToValueIndex(c, c->niceName, true);
+
+		if (c->niceName.startsWith("Value "))
+		{
+			int position = c->niceName.getTrailingIntValue();
+			if (position < 0 || position >= maxFastTokens) continue;
+			while (valuesByPosition.size() <= position) valuesByPosition.add(nullptr);
+			valuesByPosition.set(position, c);
+		}
+	}
+}
+
+void StreamingModule::addToValueIndex(Controllable * c, const String & name, bool isNiceName)
+{
+	uint32 hash = getNameHash(name.toRawUTF8(), (int)name.getNumBytesAsUTF8());
+	ValueIndexEntry e = { hash, isNiceName, c, valueIndex.contains(hash) ? valueIndex[hash] : -1 };
+	valueIndex.set(hash, valueIndexEntries.size());
+	valueIndexEntries.add(e);
+}
+
+Controllable * StreamingModule::findIndexedValue(const LineToken & token)
+{
+	uint32 hash = getNameHash(token.start, token.length);
+	if (!valueIndex.contains(hash)) return nullptr;
+
+	for (int i = valueIndex[hash]; i >= 0; i = valueIndexEntries.getReference(i).next)
+	{
+		const ValueIndexEntry &e = valueIndexEntries.getReference(i);
+		Controllable * c = e.controllable.get();
+		if (c == nullptr)
+		{
+			valueIndexDirty = true;
+			continue;
+		}
+
+		const String &name = e.isNiceName ? c->niceName : c->shortName;
+		if ((int)name.getNumBytesAsUTF8() == token.length && memcmp(name.toRawUTF8(), token.start, token.length) == 0) return c;
+	}
+
+	return nullptr;
+}
+
+uint32 StreamingModule::getNameHash(const char * data, int length)
+{
+	uint32 hash = 2166136261u; //FNV-1a
+	for (int i = 0; i < length; i++) hash = (hash ^ (uint8)data[i]) * 16777619u;
+	return hash;
+}
+
+char StreamingModule::getSeparatorChar(MessageStructure s)
+{
+	switch (s)
+	{
+	case LINES_SPACE: return ' ';
+	case LINES_TAB: return '\t';
+	case LINES_COMMA: return ',';
+	case LINES_EQUALS: return '=';
+	case LINES_COLON: return ':';
+	case LINES_SEMICOLON: return ';';
+	default: return 0;
+	}
+}
+
+float StreamingModule::getTokenFloat(const LineToken & token)
+{
+	char buffer[maxFastTokenLength + 1];
+	memcpy(buffer, token.start, token.length);
+	buffer[token.length] = 0;
+	return (float)CharacterFunctions::getDoubleValue(CharPointer_ASCII(buffer));
+}
+
+int StreamingModule::getTokenInt(const LineToken & token)
+{
+	char buffer[maxFastTokenLength + 1];
+	memcpy(buffer, token.start, token.length);
+	buffer[token.length] = 0;
+	return CharPointer_ASCII(buffer).getIntValue32();
+}
+
+void StreamingModule::childStructureChanged(ControllableContainer * cc)
+{
+	Module::childStructureChanged(cc);
+	valueIndexDirty = true;
+
+	//a bound value may have been removed or renamed, or a value with a field name added
+	if (cc == &valuesCC && !isCompilingStruct && !isCurrentlyLoadingData && messageStructure != nullptr && messageStructure->getValueDataAsEnum<MessageStructure>() == RAW_STRUCT) compileStructSchema(false);
+}
+
 void StreamingModule::processDataBytes(Array<uint8_t> data)
 {
 	if (!enabled->boolValue()) return;
@@ -311,7 +503,7 @@ void StreamingModule::processDataBytes(Array<uint8_t> data)
 			IntParameter * c = dynamic_cast<IntParameter *>(valuesCC.controllables[i]);
 			if (c != nullptr)
 			{
-				c->setValue(data[i]);
+				setInputValue(c, data[i]);
 			}
 		}
 	}
@@ -343,7 +535,7 @@ void StreamingModule::processDataBytes(Array<uint8_t> data)
 			if (c != nullptr)
 			{
 				float value = data[i * 4] + (data[i * 4 + 1] << 8) + (data[i * 4 + 2] << 16) + (data[i * 4 + 3] << 24);
-				c->setValue(value);
+				setInputValue(c, value);
 			}
 		}
 	}
@@ -375,11 +567,15 @@ void StreamingModule::processDataBytes(Array<uint8_t> data)
 			if (c != nullptr)
 			{
 				Colour col = Colour(data[i * 4], data[i * 4 + 1], data[i * 4 + 2], data[i * 4 + 3]);
-				c->setColor(col);
+				setInputValue(c, Array<var>(col.getFloatRed(), col.getFloatGreen(), col.getFloatBlue(), col.getFloatAlpha()));
 			}
 		}
 	}
 	break;
+
+	case RAW_STRUCT:
+		processStructData(data);
+		break;
             
     default:
         break;
@@ -387,6 +583,91 @@ void StreamingModule::processDataBytes(Array<uint8_t> data)
 	
 }
 
+void StreamingModule::compileStructSchema(bool createValues)
+{
+	ScopedValueSetter<bool> compiling(isCompilingStruct, true); //created values change the structure
+	std::unique_ptr<BinaryStructDecoder> decoder;
+	Array<StructBinding> bindings;
+
+	if (messageStructure->getValueDataAsEnum<MessageStructure>() == RAW_STRUCT)
+	{
+		String error;
+		decoder.reset(BinaryStructDecoder::compile(structSchema->stringValue(), error));
+		if (decoder == nullptr)
+		{
+			if (createValues) NLOGERROR(niceName, "Invalid structure : " << error);
+			structSchema->setWarningMessage(error);
+		}
+		else
+		{
+			structSchema->clearWarning();
+
+			//vectors of 2 or 3 values go to a single point parameter, longer arrays to one value per item
+			for (auto &f : decoder->fields)
+			{
+				if (f.count <= 3)
+				{
+					bindings.add({ createStructValue(f, f.name, f.count, createValues), f.valueIndex, f.count });
+				}
+				else
+				{
+					for (int i = 0; i < f.count; i++) bindings.add({ createStructValue(f, f.name + " " + String(i + 1), 1, createValues), f.valueIndex + i, 1 });
+				}
+			}
+		}
+	}
+
+	const ScopedLock lock(structLock);
+	if (decoder != nullptr) structValues.allocate(decoder->numValues, true);
+	structDecoder.swap(decoder);
+	structBindings.swapWith(bindings);
+}
+
+Controllable * StreamingModule::createStructValue(const BinaryStructDecoder::Field &f, const String &name, int numValues, bool createValues)
+{
+	Controllable * c = valuesCC.getControllableByName(name, true);
+	if (c != nullptr || !createValues || !autoAdd->boolValue()) return c;
+
+	if (numValues == 2) c = new Point2DParameter(name, name);
+	else if (numValues == 3) c = new Point3DParameter(name, name);
+	else if (f.isInteger() && f.scale == 1) c = new IntParameter(name, name, 0);
+	else c = new FloatParameter(name, name, 0);
+
+	c->isCustomizableByUser = true;
+	c->isRemovableByUser = true;
+	c->saveValueOnly = false;
+	valuesCC.addControllable(c);
+	return c;
+}
+
+void StreamingModule::processStructData(const Array<uint8> &data)
+{
+	const ScopedLock lock(structLock);
+	if (structDecoder == nullptr) return;
+
+	BinaryStructDecoder::Result result = structDecoder->decode(data.getRawDataPointer(), data.size(), structValues);
+	if (result != BinaryStructDecoder::OK)
+	{
+		if (logIncomingData->boolValue()) NLOGWARNING(niceName, (result == BinaryStructDecoder::TOO_SHORT ? "Message is shorter than the structure, ignoring" : "Checksum mismatch, ignoring message"));
+		return;
+	}
+
+	for (auto &b : structBindings)
+	{
+		if (b.controllable == nullptr) continue;
+		if (b.numValues == 1)
+		{
+			setInputValue(b.controllable, structValues[b.valueIndex]);
+		}
+		else
+		{
+			var v = var(Array<var>()); //initialize force array
+			for (int i = 0; i < b.numValues; i++) v.append(structValues[b.valueIndex + i]);
+			setInputValue(b.controllable, v);
+		}
+	}
+}
+
 void StreamingModule::sendMessage(const String & message)
 {
 	if (!enabled->boolValue()) return;
@@ -470,11 +751,18 @@ void StreamingModule::onControllableFeedbackUpdateInternal(ControllableContainer
 	{
 		buildMessageStructureOptions();
 	} 
+
+	if (c == messageStructure || c == structSchema)
+	{
+		structSchema->setEnabled(messageStructure->getValueDataAsEnum<MessageStructure>() == RAW_STRUCT);
+		if (!isCurrentlyLoadingData) compileStructSchema();
+	}
 }
 
 void StreamingModule::loadJSONDataInternal(var data)
 {
 	Module::loadJSONDataInternal(data);
+	compileStructSchema(); //bind to the values that were just loaded
 	for (auto& v : valuesCC.controllables) v->isCustomizableByUser = true;
 }
 
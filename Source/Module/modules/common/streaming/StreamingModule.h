@@ -12,6 +12,7 @@
 
 #include "Module/Module.h"
 #include "Common/Serial/lib/cobs/cobs.h"
+#include "BinaryStructDecoder.h"
 
 class StreamingModule :
 	public Module
@@ -21,12 +22,13 @@ public:
 	virtual ~StreamingModule();
 
 	enum StreamingType { LINES, DATA255, RAW, COBS };
-	enum MessageStructure { LINES_SPACE, LINES_TAB, LINES_COMMA, LINES_COLON, LINES_SEMICOLON, LINES_EQUALS, NO_SEPARATION, RAW_1BYTE, RAW_FLOATS, RAW_COLORS};
+	enum MessageStructure { LINES_SPACE, LINES_TAB, LINES_COMMA, LINES_COLON, LINES_SEMICOLON, LINES_EQUALS, NO_SEPARATION, RAW_1BYTE, RAW_FLOATS, RAW_COLORS, RAW_STRUCT};
 	EnumParameter * streamingType;
 
 	BoolParameter * autoAdd;
 	EnumParameter * messageStructure;
 	BoolParameter * firstValueIsTheName;
+	StringParameter * structSchema;
 
 	const Identifier dataEventId = "dataReceived";
 	const Identifier sendId = "send";
@@ -38,6 +40,43 @@ public:
 
 	virtual void processDataLine(const String &message);
 	virtual void processDataLineInternal(const String &message) {}
+
+	//Fast path for lines whose values already exist : tokens are read in place and numbers are parsed without intermediate Strings
+	struct LineToken { const char * start; int length; };
+	struct ValueIndexEntry { uint32 hash; bool isNiceName; WeakReference<Controllable> controllable; int next; };
+	static const int maxFastTokens = 16;
+	static const int maxFastTokenLength = 63;
+
+	HashMap<uint32, int> valueIndex; //name hash > first entry
+	Array<ValueIndexEntry> valueIndexEntries;
+	Array<WeakReference<Controllable>> valuesByPosition; //"Value N" values, when the first value is not the name
+	std::atomic<bool> valueIndexDirty;
+	bool lastLookupMissed;
+
+	bool processDataLineFast(const String &message, MessageStructure s);
+	bool applyTokens(Controllable * c, const LineToken * tokens, int numArgs);
+	void rebuildValueIndex();
+	void addToValueIndex(Controllable * c, const String &name, bool isNiceName);
+	Controllable * findIndexedValue(const LineToken &token);
+	static uint32 getNameHash(const char * data, int length);
+	static char getSeparatorChar(MessageStructure s);
+	static float getTokenFloat(const LineToken &token);
+	static int getTokenInt(const LineToken &token);
+
+	void childStructureChanged(ControllableContainer * cc) override;
+
+	//Custom structure : the schema is compiled once and each decoded field is bound to its value
+	struct StructBinding { WeakReference<Controllable> controllable; int valueIndex; int numValues; };
+	std::unique_ptr<BinaryStructDecoder> structDecoder;
+	Array<StructBinding> structBindings;
+	HeapBlock<double> structValues;
+	CriticalSection structLock;
+	bool isCompilingStruct;
+
+	void compileStructSchema(bool createValues = true); //values are only bound, not created, when the module structure changes
+	Controllable * createStructValue(const BinaryStructDecoder::Field &f, const String &name, int numValues, bool createValues);
+	void processStructData(const Array<uint8> &data);
+
 	virtual void processDataBytes(Array<uint8> data);
 	virtual void processDataBytesInternal(Array<uint8> data) {}
 
@@ -168,7 +168,7 @@ var DMXModule::sendDMXFromScript(const var::NativeFunctionArgs& args)
 
 void DMXModule::clearItem()
 {
-	BaseItem::clearItem();
+	Module::clearItem();
 	setCurrentDMXDevice(nullptr);
 }
 
@@ -212,24 +212,27 @@ void DMXModule::dmxDeviceDisconnected()
 
 void DMXModule::dmxDataInChanged(int channel, int value)
 {
-	if (logIncomingData->boolValue()) NLOG(niceName, "DMX In : " + String(channel) + " > " + String(value));
-	inActivityTrigger->trigger();
-
-	IntParameter * dVal = channelMap.contains(channel) ? channelMap[channel] : nullptr;
-	if (dVal == nullptr)
+	postInput([this, channel, value]()
 	{
-		if (!autoAdd->boolValue()) return;
+		if (logIncomingData->boolValue()) NLOG(niceName, "DMX In : " + String(channel) + " > " + String(value));
+		inActivityTrigger->trigger();
 
-		dVal = new IntParameter("Channel " + String(channel), "DMX Value for channel " + String(channel), 0, 0, 255);
-		dVal->isRemovableByUser = true;
-		valuesCC.addParameter(dVal);
+		IntParameter* dVal = channelMap.contains(channel) ? channelMap[channel] : nullptr;
+		if (dVal == nullptr)
+		{
+			if (!autoAdd->boolValue()) return;
 
-		//dVal->setControllableFeedbackOnly(true);
-		dVal->saveValueOnly = false;
-		channelMap.set(channel, dVal);
-	}
+			dVal = new IntParameter("Channel " + String(channel), "DMX Value for channel " + String(channel), 0, 0, 255);
+			dVal->isRemovableByUser = true;
+			valuesCC.addParameter(dVal);
+
+			//dVal->setControllableFeedbackOnly(true);
+			dVal->saveValueOnly = false;
+			channelMap.set(channel, dVal);
+		}
 
-	dVal->setValue(value);
+		dVal->setValue(value);
+	});
 }
 
 void DMXModule::showMenuAndCreateValue(ControllableContainer * container)
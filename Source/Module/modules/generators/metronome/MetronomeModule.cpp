@@ -11,7 +11,9 @@
 #include "MetronomeModule.h"
 
 MetronomeModule::MetronomeModule() :
-	Module(getTypeString())
+	Module(getTypeString()),
+	timeToNextTick(0),
+	timeToTickOff(0)
 {
 	setupIOConfiguration(true, false);
 
@@ -20,13 +22,15 @@ MetronomeModule::MetronomeModule() :
 	random = moduleParams.addFloatParameter("Randomness", "Amount of randomness in each call", 0, 0, 1);
 
 	tick = valuesCC.addBoolParameter("Tick", "When the metronome is ticking", false);
-	startTimer(0, 1000.0f / frequency->floatValue());
+	timeToNextTick = 1.0 / frequency->floatValue();
+	EngineClock::getInstance()->addClockListener(this);
 
 	for (auto &c : valuesCC.controllables) c->isControllableFeedbackOnly = true;
 }
 
 MetronomeModule::~MetronomeModule()
 {
+	if (EngineClock::getInstanceWithoutCreating() != nullptr) EngineClock::getInstance()->removeClockListener(this);
 }
 
 void MetronomeModule::onControllableFeedbackUpdateInternal(ControllableContainer * cc, Controllable * c)
@@ -35,30 +39,37 @@ void MetronomeModule::onControllableFeedbackUpdateInternal(ControllableContainer
 
 	if (c == frequency)
 	{
-		if (isTimerRunning(0)) stopTimer(0);
-		startTimer(0, 1000.0f / frequency->floatValue());
+		timeToNextTick = 1.0 / frequency->floatValue();
 	}
 }
 
-void MetronomeModule::timerCallback(int timerID)
+void MetronomeModule::engineTick(double deltaTime)
 {
 	if (!enabled->boolValue()) return;
-	if (timerID == 0)
+
+	if (tick->boolValue())
 	{
+		timeToTickOff -= deltaTime;
+		if (timeToTickOff <= 0) tick->setValue(false);
+	}
+
+	timeToNextTick -= deltaTime;
+	if (timeToNextTick < -1) timeToNextTick = 0; //after a stall, don't burst all the missed ticks
+
+	//when the frequency is higher than the clock rate, several ticks can be due at once and each of them is emitted
+	while (timeToNextTick <= 0)
+	{
+		if (tick->boolValue()) tick->setValue(false);
 		tick->setValue(true);
 		inActivityTrigger->trigger();
-		float nextTime = 1000 / frequency->floatValue();
-		
+		double nextTime = 1.0 / frequency->floatValue();
+
 		if (random->floatValue() > 0)
 		{
 			nextTime = (1 - rnd.nextFloat()*random->floatValue())*nextTime;
-			startTimer(0, nextTime);
 		}
 
-		startTimer(1, onTime->floatValue() * nextTime);
-	} else if (timerID == 1)
-	{
-		tick->setValue(false);
-		stopTimer(1);
+		timeToNextTick += nextTime;
+		timeToTickOff = timeToNextTick - nextTime + onTime->floatValue() * nextTime; //counted from when this tick was due
 	}
 }
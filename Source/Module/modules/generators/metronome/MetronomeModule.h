@@ -10,10 +10,11 @@
 
 #pragma once
 #include "Module/Module.h"
+#include "Common/Engine/EngineClock.h"
 
 class MetronomeModule :
 	public Module,
-	public MultiTimer
+	public EngineClock::ClockListener
 {
 public:
 	MetronomeModule();
@@ -25,12 +26,14 @@ public:
 	FloatParameter * random;
 	Random rnd;
 
+	double timeToNextTick;
+	double timeToTickOff;
+
 	void onControllableFeedbackUpdateInternal(ControllableContainer * cc, Controllable * c) override;
 
 	String getTypeString() const override { return "Metronome"; }
 	static MetronomeModule * create() { return new MetronomeModule(); }
 
 
-	// Inherited via Timer
-	virtual void timerCallback(int timerID) override;
+	virtual void engineTick(double deltaTime) override;
 };
\ No newline at end of file
@@ -12,13 +12,14 @@
 
 SignalModule::SignalModule() :
 	Module(getTypeString()),
-	progression(0)
+	progression(0),
+	timeSinceLastUpdate(0)
 {
 	setupIOConfiguration(true, false);
 
 	type = moduleParams.addEnumParameter("Type", "Signal type");
 	type->addOption("Sine", SINE)->addOption("Saw",SAW)->addOption("Triangle",TRIANGLE)->addOption("Perlin", PERLIN);
-	refreshRate = moduleParams.addFloatParameter("Refresh Rate", "Time interval between value updates, in Hz", 50, 1, 200);
+	refreshRate = moduleParams.addFloatParameter("Refresh Rate", "Time interval between value updates, in Hz. The effective rate cannot be higher than the engine clock tick rate", 50, 1, 200);
 	amplitude = moduleParams.addFloatParameter("Amplitude", "Amplitude of the signal, act as a multiplier", 1, 0);
 	offset = moduleParams.addFloatParameter("Offset", "Offset the signal value", 0);
 
@@ -29,11 +30,12 @@ SignalModule::SignalModule() :
 
 	for (auto &c : valuesCC.controllables) c->isControllableFeedbackOnly = true;
 
-	startTimer(0,1000.0f/refreshRate->floatValue());
+	EngineClock::getInstance()->addClockListener(this);
 }
 
 SignalModule::~SignalModule()
 {
+	if (EngineClock::getInstanceWithoutCreating() != nullptr) EngineClock::getInstance()->removeClockListener(this);
 }
 
 void SignalModule::onControllableFeedbackUpdateInternal(ControllableContainer * cc, Controllable * c)
@@ -43,51 +45,47 @@ void SignalModule::onControllableFeedbackUpdateInternal(ControllableContainer *
 	if (c == amplitude || c == offset)
 	{
 		value->setRange(offset->floatValue(), amplitude->floatValue() + offset->floatValue());
-	}else if (c == refreshRate)
-	{
-		startTimer(0, 1000.0f / refreshRate->floatValue());
 	}else if(c == type)	
 	{
 		octaves->setEnabled(type->getValueDataAsEnum<SignalType>() == PERLIN);
 	}
 }
 
-void SignalModule::timerCallback(int timerID)
+void SignalModule::engineTick(double deltaTime)
 {
 	if (!enabled->boolValue()) return;
 
-	if (timerID == 0)
-	{
-		SignalType t = type->getValueDataAsEnum<SignalType>();
+	timeSinceLastUpdate += deltaTime;
+	if (timeSinceLastUpdate < 1.0 / refreshRate->floatValue()) return;
 
-		float val = 0;
-		progression = progression + getTimerInterval(0)*frequency->floatValue() / 1000.0f;
+	SignalType t = type->getValueDataAsEnum<SignalType>();
 
+	float val = 0;
+	progression = progression + (float)timeSinceLastUpdate*frequency->floatValue();
+	timeSinceLastUpdate = 0;
 
-		switch (t)
-		{
-		case SINE:
-			val = sinf(progression*MathConstants<float>::pi*2)*.5f + .5f;
-			break;
 
-		case TRIANGLE:
-			val = fabsf(fmodf(progression, 2) - 1);
-			break;
+	switch (t)
+	{
+	case SINE:
+		val = sinf(progression*MathConstants<float>::pi*2)*.5f + .5f;
+		break;
 
-		case SAW:
-			val = fmodf(progression,1);
-			break;
+	case TRIANGLE:
+		val = fabsf(fmodf(progression, 2) - 1);
+		break;
 
-		case PERLIN:
-			val = perlin.octaveNoise0_1(progression, octaves->intValue());
-			break;
-		}
+	case SAW:
+		val = fmodf(progression,1);
+		break;
 
+	case PERLIN:
+		val = perlin.octaveNoise0_1(progression, octaves->intValue());
+		break;
+	}
 
 
-		value->setNormalizedValue(val);
-		inActivityTrigger->trigger();
-	}
 
-	
+	value->setNormalizedValue(val);
+	inActivityTrigger->trigger();
 }
@@ -12,12 +12,13 @@
 
 #include "Module/Module.h"
 #include "PerlinNoise.hpp"
+#include "Common/Engine/EngineClock.h"
 
 using namespace siv;
 
 class SignalModule :
 	public Module,
-	public MultiTimer
+	public EngineClock::ClockListener
 {
 public:
 	SignalModule();
@@ -26,6 +27,7 @@ public:
 	enum SignalType { SINE, SAW, TRIANGLE, PERLIN };
 
 	float progression;
+	double timeSinceLastUpdate;
 
 	EnumParameter * type;
 	FloatParameter * refreshRate;
@@ -46,6 +48,5 @@ public:
 	String getTypeString() const override { return "Signal"; }
 	static SignalModule * create() { return new SignalModule(); }
 
-	// Inherited via Timer
-	virtual void timerCallback(int timerID) override;
+	virtual void engineTick(double deltaTime) override;
 };
\ No newline at end of file
@@ -199,56 +199,70 @@ void MIDIModule::updateMIDIDevices()
 void MIDIModule::noteOnReceived(const int & channel, const int & pitch, const int & velocity)
 {
 	if (!enabled->boolValue()) return; 
-	inActivityTrigger->trigger();
-	if (logIncomingData->boolValue())  NLOG(niceName, "Note On : " << channel << ", " << MIDIManager::getNoteName(pitch) << ", " << velocity);
 
-	if (useGenericControls) updateValue(channel, MIDIManager::getNoteName(pitch), velocity, MIDIValueParameter::NOTE_ON, pitch);
+	postInput([this, channel, pitch, velocity]()
+	{
+		inActivityTrigger->trigger();
+		if (logIncomingData->boolValue())  NLOG(niceName, "Note On : " << channel << ", " << MIDIManager::getNoteName(pitch) << ", " << velocity);
+
+		if (useGenericControls) updateValue(channel, MIDIManager::getNoteName(pitch), velocity, MIDIValueParameter::NOTE_ON, pitch);
 
-	if (scriptManager->items.size() > 0) scriptManager->callFunctionOnAllItems(noteOnEventId, Array<var>(channel, pitch, velocity));
+		if (scriptManager->items.size() > 0) scriptManager->callFunctionOnAllItems(noteOnEventId, Array<var>(channel, pitch, velocity));
+	});
 }
 
 void MIDIModule::noteOffReceived(const int & channel, const int & pitch, const int & velocity)
 {
 	if (!enabled->boolValue()) return; 
-	inActivityTrigger->trigger();
-	if (logIncomingData->boolValue()) NLOG(niceName, "Note Off : " << channel << ", " << MIDIManager::getNoteName(pitch) << ", " << velocity);
 
-	if (useGenericControls) updateValue(channel, MIDIManager::getNoteName(pitch), velocity, MIDIValueParameter::NOTE_OFF, pitch);
+	postInput([this, channel, pitch, velocity]()
+	{
+		inActivityTrigger->trigger();
+		if (logIncomingData->boolValue()) NLOG(niceName, "Note Off : " << channel << ", " << MIDIManager::getNoteName(pitch) << ", " << velocity);
 
-	if (scriptManager->items.size() > 0) scriptManager->callFunctionOnAllItems(noteOffEventId, Array<var>(channel, pitch, velocity));
-	
+		if (useGenericControls) updateValue(channel, MIDIManager::getNoteName(pitch), velocity, MIDIValueParameter::NOTE_OFF, pitch);
+
+		if (scriptManager->items.size() > 0) scriptManager->callFunctionOnAllItems(noteOffEventId, Array<var>(channel, pitch, velocity));
+	});
 }
 
 void MIDIModule::controlChangeReceived(const int & channel, const int & number, const int & value)
 {
 	if (!enabled->boolValue()) return; 
-	inActivityTrigger->trigger();
-	if (logIncomingData->boolValue()) NLOG(niceName, "Control Change : " << channel << ", " << number << ", " << value);
 
-	if (useGenericControls) updateValue(channel, "CC"+String(number), value, MIDIValueParameter::CONTROL_CHANGE, number);
+	postInput([this, channel, number, value]()
+	{
+		inActivityTrigger->trigger();
+		if (logIncomingData->boolValue()) NLOG(niceName, "Control Change : " << channel << ", " << number << ", " << value);
 
-	if (scriptManager->items.size() > 0) scriptManager->callFunctionOnAllItems(ccEventId, Array<var>(channel, number, value));
+		if (useGenericControls) updateValue(channel, "CC" + String(number), value, MIDIValueParameter::CONTROL_CHANGE, number);
 
+		if (scriptManager->items.size() > 0) scriptManager->callFunctionOnAllItems(ccEventId, Array<var>(channel, number, value));
+	});
 }
 
 void MIDIModule::sysExReceived(const MidiMessage & msg)
 {
 	if (!enabled->boolValue()) return;
-	inActivityTrigger->trigger(); 
 
 	Array<uint8> data(msg.getSysExData(), msg.getSysExDataSize());
 
-	if (logIncomingData->boolValue())
+	postInput([this, data]()
 	{
-		String log = "Sysex received, " + String(data.size()) + " bytes";
-		for (int i = 0; i < data.size(); i++)
+		inActivityTrigger->trigger();
+
+		if (logIncomingData->boolValue())
 		{
-			log += "\n" + String(data[i]);
+			String log = "Sysex received, " + String(data.size()) + " bytes";
+			for (int i = 0; i < data.size(); i++)
+			{
+				log += "\n" + String(data[i]);
+			}
+			NLOG(niceName, log);
 		}
-		NLOG(niceName, log);
-	}
 
-	if (scriptManager->items.size() > 0) scriptManager->callFunctionOnAllItems(sysexEventId, Array<var>(data.getRawDataPointer(), data.size()));
+		if (scriptManager->items.size() > 0) scriptManager->callFunctionOnAllItems(sysexEventId, Array<var>(data.getRawDataPointer(), data.size()));
+	});
 }
 
 void MIDIModule::fullFrameTimecodeReceived(const MidiMessage& msg)
@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+    OSCBundleScheduler.cpp
+    Created: 17 Oct 2026 9:03:27pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "OSCBundleScheduler.h"
+#include "OSCModule.h"
+
+OSCBundleScheduler::OSCBundleScheduler(OSCModule * module) :
+	Thread("OSC Scheduler " + module->niceName),
+	module(module),
+	numScheduled(0),
+	numLate(0),
+	nextOrder(0)
+{
+}
+
+OSCBundleScheduler::~OSCBundleScheduler()
+{
+	stopThread(1000);
+}
+
+double OSCBundleScheduler::getDelayForTimeTag(const OSCTimeTag & t)
+{
+	//OSC time tags are NTP time : seconds since 1900 in the upper 32 bits, fraction of second in the lower 32 bits
+	const uint64 raw = t.getRawTimeTag();
+	const double secondsSince1970 = (double)(raw >> 32) - 2208988800.0 + (double)(raw & 0xFFFFFFFF) / 4294967296.0;
+	return secondsSince1970 * 1000.0 - (double)Time::currentTimeMillis();
+}
+
+void OSCBundleScheduler::schedule(std::shared_ptr<OSCReceivedPacket> bundle, double delayMs)
+{
+	{
+		const ScopedLock lock(queueLock);
+		DueTimeComparator comparator;
+		queue.addSorted(comparator, { Time::getMillisecondCounterHiRes() + delayMs, nextOrder++, bundle });
+	}
+
+	numScheduled++;
+	if (!isThreadRunning()) startThread(8);
+	notify();
+}
+
+void OSCBundleScheduler::clear()
+{
+	const ScopedLock lock(queueLock);
+	queue.clear();
+}
+
+void OSCBundleScheduler::run()
+{
+	while (!threadShouldExit())
+	{
+		double msToWait = 100;
+		std::shared_ptr<OSCReceivedPacket> dueBundle;
+
+		{
+			const ScopedLock lock(queueLock);
+			if (queue.size() > 0)
+			{
+				msToWait = queue.getReference(0).dueTime - Time::getMillisecondCounterHiRes();
+				if (msToWait <= 0)
+				{
+					dueBundle = queue.getReference(0).bundle;
+					queue.remove(0);
+				}
+			}
+		}
+
+		if (dueBundle != nullptr)
+		{
+			module->dispatchPacket(dueBundle);
+			continue;
+		}
+
+		//sleep until close to the due time, then yield for the last millisecond for precision
+		if (msToWait > 2) wait(jmin((int)msToWait - 1, 100));
+		else Thread::yield();
+	}
+}
@@ -0,0 +1,64 @@
+/*
+  ==============================================================================
+
+    OSCBundleScheduler.h
+    Created: 17 Oct 2026 9:03:27pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "transport/OSCPacketCodec.h"
+
+class OSCModule;
+
+/*
+	Holds future-dated OSC bundles and dispatches them to their module when their time tag is reached.
+	Time tags are converted once from the system clock to the high resolution counter, which is then used for the scheduling.
+*/
+class OSCBundleScheduler :
+	public Thread
+{
+public:
+	OSCBundleScheduler(OSCModule * module);
+	~OSCBundleScheduler();
+
+	OSCModule * module;
+
+	std::atomic<int> numScheduled;
+	std::atomic<int> numLate;
+
+	//returns the delay in milliseconds before the time tag is reached, negative if it is already passed
+	static double getDelayForTimeTag(const OSCTimeTag &t);
+
+	void schedule(std::shared_ptr<OSCReceivedPacket> bundle, double delayMs);
+	void clear();
+
+	void run() override;
+
+private:
+	struct ScheduledBundle
+	{
+		double dueTime; //Time::getMillisecondCounterHiRes() based
+		int64 order;
+		std::shared_ptr<OSCReceivedPacket> bundle;
+	};
+
+	class DueTimeComparator
+	{
+	public:
+		int compareElements(const ScheduledBundle &a, const ScheduledBundle &b)
+		{
+			if (a.dueTime != b.dueTime) return a.dueTime < b.dueTime ? -1 : 1;
+			return a.order < b.order ? -1 : (a.order > b.order ? 1 : 0);
+		}
+	};
+
+	CriticalSection queueLock;
+	Array<ScheduledBundle> queue; //sorted by due time, then by arrival order
+	int64 nextOrder;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OSCBundleScheduler)
+};
@@ -18,7 +18,19 @@ OSCModule::OSCModule(const String & name, int defaultLocalPort, int defaultRemot
 	Module(name),
 	Thread("OSCZeroconf"),
 	localPort(nullptr),
+	processMode(nullptr),
+	honorTimeTags(nullptr),
+	maxTimeTagDelay(nullptr),
+	dropBeyondMaxDelay(nullptr),
+	lateBundles(nullptr),
+	inputTransport(nullptr),
+	numTCPClients(nullptr),
+	multicastGroup(nullptr),
+	multicastInterface(nullptr),
+	receiver(this),
+	lastTimeTagWarning(0),
     servus("_osc._udp"),
+	tcpServus("_osc._tcp"),
 	receiveCC(nullptr)
 {
 	
@@ -37,8 +49,43 @@ OSCModule::OSCModule(const String & name, int defaultLocalPort, int defaultRemot
 		localPort->hideInOutliner = true;
 		localPort->warningResolveInspectable = this;
 
-		receiver.registerFormatErrorHandler(&OSCHelpers::logOSCFormatError);
-		receiver.addListener(this);
+		inputTransport = receiveCC->addEnumParameter("Transport", "UDP receives datagrams. TCP accepts connections from any number of clients, with packets framed using SLIP (OSC 1.1) or a size prefix (OSC 1.0).");
+		OSCOutput::addTransportOptions(inputTransport);
+		inputTransport->hideInOutliner = true;
+
+		numTCPClients = receiveCC->addIntParameter("TCP Clients", "Number of TCP clients currently connected", 0, 0);
+		numTCPClients->setControllableFeedbackOnly(true);
+		numTCPClients->isSavable = false;
+		numTCPClients->hideInOutliner = true;
+
+		multicastGroup = receiveCC->addStringParameter("Multicast Group", "In UDP, the multicast group to join (224.0.0.0 to 239.255.255.255). Leave empty to only receive messages sent to this machine.", "");
+		multicastGroup->autoTrim = true;
+		multicastGroup->hideInOutliner = true;
+		multicastInterface = receiveCC->addStringParameter("Multicast Interface", "The IP of the network interface on which to join the group. Leave empty to let the system choose.", "");
+		multicastInterface->autoTrim = true;
+		multicastInterface->hideInOutliner = true;
+
+		processMode = receiveCC->addEnumParameter("Process Mode", "Where incoming messages are processed.\nDefault uses the engine thread if enabled, or the receiving thread otherwise.\nReceiver Thread processes messages as soon as they are received.\nModule Worker uses a thread dedicated to this module, so a high message rate does not delay the receiver or other modules.");
+		processMode->addOption("Default", PROCESS_DEFAULT)->addOption("Receiver Thread", PROCESS_RECEIVER)->addOption("Module Worker", PROCESS_WORKER);
+		processMode->hideInOutliner = true;
+
+		honorTimeTags = receiveCC->addBoolParameter("Honor Time Tags", "If checked, bundles with a time tag in the future are held and processed when their time comes. Bundles tagged as immediate are always processed right away.", false);
+		honorTimeTags->hideInOutliner = true;
+		maxTimeTagDelay = receiveCC->addIntParameter("Max Time Tag Delay", "When honoring time tags, the longest time in milliseconds a bundle can be held. A sender with a wrong clock could otherwise have its bundles held for hours.", 10000, 0, 3600000);
+		maxTimeTagDelay->hideInOutliner = true;
+		maxTimeTagDelay->setEnabled(false);
+		dropBeyondMaxDelay = receiveCC->addBoolParameter("Drop Beyond Max Delay", "If checked, bundles tagged further in the future than Max Time Tag Delay are dropped. Otherwise they are processed right away.", false);
+		dropBeyondMaxDelay->hideInOutliner = true;
+		dropBeyondMaxDelay->setEnabled(false);
+		lateBundles = receiveCC->addIntParameter("Late Bundles", "Number of received bundles whose time tag was already passed on arrival", 0, 0);
+		lateBundles->setControllableFeedbackOnly(true);
+		lateBundles->isSavable = false;
+		lateBundles->hideInOutliner = true;
+
+		bundleScheduler.reset(new OSCBundleScheduler(this));
+
+		recorder.reset(new OSCTrafficRecorder(this));
+		moduleParams.addChildControllableContainer(recorder.get());
 
 		if(!Engine::mainEngine->isLoadingFile) setupReceiver();
 	} else
@@ -70,6 +117,10 @@ OSCModule::OSCModule(const String & name, int defaultLocalPort, int defaultRemot
 
 	//Script
 	scriptObject.setMethod(sendOSCId, OSCModule::sendOSCFromScript);
+	scriptObject.setMethod(getBlobSizeId, OSCModule::getBlobSizeFromScript);
+	scriptObject.setMethod(getBlobBytesId, OSCModule::getBlobBytesFromScript);
+	scriptObject.setMethod(getBlobIntsId, OSCModule::getBlobIntsFromScript);
+	scriptObject.setMethod(getBlobFloatsId, OSCModule::getBlobFloatsFromScript);
 	scriptManager->scriptTemplate += ChataigneAssetManager::getInstance()->getScriptTemplate("osc");
 
 
@@ -78,6 +129,15 @@ OSCModule::OSCModule(const String & name, int defaultLocalPort, int defaultRemot
 
 OSCModule::~OSCModule()
 {
+	disconnectReceiver();
+	tcpServer.reset();
+
+	//nothing is dispatched anymore once the replay is stopped, then the pending functions are dropped with their threads
+	if (recorder != nullptr) recorder->stopReplay();
+	bundleScheduler.reset();
+	receiveWorker.reset();
+	recorder.reset();
+
 	if (isThreadRunning())
 	{
 		signalThreadShouldExit();
@@ -86,9 +146,18 @@ OSCModule::~OSCModule()
 	}
 }
 
-void OSCModule::setupReceiver()
+void OSCModule::disconnectReceiver()
 {
+	//the receiver doesn't shut down a socket it doesn't own, its thread would stay blocked in read
+	if (multicastSocket != nullptr) multicastSocket->shutdown();
 	receiver.disconnect();
+	multicastSocket.reset();
+}
+
+void OSCModule::setupReceiver()
+{
+	disconnectReceiver();
+	if (tcpServer != nullptr) tcpServer->stop();
 	if (receiveCC == nullptr) return;
 
 	if (!receiveCC->enabled->boolValue())
@@ -98,11 +167,43 @@ void OSCModule::setupReceiver()
 	}
 
 	//DBG("Local port set to : " << localPort->intValue());
-	bool result = receiver.connect(localPort->intValue());
+	OSCOutput::Transport t = inputTransport->getValueDataAsEnum<OSCOutput::Transport>();
+	bool result = false;
+	String group = t == OSCOutput::UDP ? multicastGroup->stringValue() : String();
+	if (group.isNotEmpty() && !OSCMulticast::isMulticastAddress(group))
+	{
+		NLOGERROR(niceName, group + " is not a multicast group address");
+		localPort->setWarningMessage(group + " is not a multicast group address");
+		return;
+	}
+
+	String itf = group.isNotEmpty() ? multicastInterface->stringValue() : String();
+	StringArray interfaces = OSCMulticast::getInterfaceAddresses();
+	if (itf.isNotEmpty() && !interfaces.contains(itf))
+	{
+		NLOGERROR(niceName, itf + " is not the address of a network interface on this machine, available interfaces : " + interfaces.joinIntoString(", "));
+		localPort->setWarningMessage(itf + " is not the address of a network interface on this machine");
+		return;
+	}
+
+	if (t == OSCOutput::UDP)
+	{
+		if (group.isEmpty()) result = receiver.connect(localPort->intValue());
+		else
+		{
+			multicastSocket.reset(new DatagramSocket(false));
+			result = OSCMulticast::bindAndJoin(*multicastSocket, localPort->intValue(), group, multicastInterface->stringValue()) && receiver.connectToSocket(*multicastSocket);
+		}
+	}
+	else
+	{
+		if (tcpServer == nullptr) tcpServer.reset(new OSCTCPServer(this));
+		result = tcpServer->start(localPort->intValue(), OSCOutput::getFramingForTransport(t));
+	}
 
 	if (result)
 	{
-		NLOG(niceName, "Now receiving on port : " + localPort->stringValue());
+		NLOG(niceName, "Now receiving on port : " + localPort->stringValue() + (t == OSCOutput::UDP ? "" : " (TCP)") + (group.isNotEmpty() ? ", multicast group " + group : ""));
 		if(!isThreadRunning() && !Engine::mainEngine->isLoadingFile) startThread();
 
 		Array<IPAddress> ad;
@@ -118,7 +219,8 @@ void OSCModule::setupReceiver()
 		localPort->clearWarning();
 	} else
 	{
-		NLOGERROR(niceName, "Error binding port " + localPort->stringValue());
+		if (multicastSocket != nullptr) NLOGERROR(niceName, "Error binding port " + localPort->stringValue() + " or joining multicast group " + group);
+		else NLOGERROR(niceName, "Error binding port " + localPort->stringValue());
 		localPort->setWarningMessage("Error binding port " + localPort->stringValue());
 	}
 	
@@ -163,8 +265,40 @@ Colour OSCModule::getColorArg(OSCArgument a)
 	return Colours::black;
 }
 
-void OSCModule::processMessage(const OSCMessage & msg)
+double OSCModule::getDoubleArg(const OSCReceivedMessage & m, int index)
+{
+	if (index < m.values.size())
+	{
+		const var &v = m.values.getReference(index);
+		if (v.isDouble() || v.isInt64() || v.isInt()) return (double)v;
+	}
+
+	return getFloatArg(m.message[index]);
+}
+
+void OSCModule::packetReceived(const void * data, size_t size)
+{
+	if (!enabled->boolValue()) return;
+	if (recorder != nullptr && recorder->isRecording) recorder->recordPacket(data, size);
+
+	std::shared_ptr<OSCReceivedPacket> packet;
+	try
+	{
+		packet = OSCPacketCodec::decodePacket(data, size);
+	}
+	catch (OSCFormatError &e)
+	{
+		if (logIncomingData->boolValue()) NLOGWARNING(niceName, "Invalid OSC packet received : " << e.description);
+		return;
+	}
+
+	handleIncomingPacket(packet);
+}
+
+void OSCModule::processMessage(const OSCReceivedMessage & m)
 {
+	const OSCMessage &msg = m.message;
+
 	if (logIncomingData->boolValue())
 	{
 		String s = "";
@@ -173,19 +307,70 @@ void OSCModule::processMessage(const OSCMessage & msg)
 	}
 
 	inActivityTrigger->trigger();
-	processMessageInternal(msg);
+	processMessageInternal(m);
 
 	if (scriptManager->items.size() > 0)
 	{
 		Array<var> params;
 		params.add(msg.getAddressPattern().toString());
 		var args = var(Array<var>()); //initialize force array
-		for (auto &a : msg) args.append(OSCModule::argumentToVar(a));
+		for (auto &v : m.values) args.append(v); //blobs are binary vars, read with the getBlob methods
 		params.add(args);
 		scriptManager->callFunctionOnAllItems(oscEventId, params);
 	}
 }
 
+void OSCModule::processIncoming(EngineInputQueue::InputFunction inputFunc)
+{
+	ProcessMode m = processMode != nullptr ? processMode->getValueDataAsEnum<ProcessMode>() : PROCESS_DEFAULT;
+
+	switch (m)
+	{
+	case PROCESS_RECEIVER:
+		inputFunc();
+		break;
+
+	case PROCESS_WORKER:
+	{
+		const SpinLock::ScopedLockType sl(workerLock);
+		if (receiveWorker != nullptr)
+		{
+			if (!receiveWorker->post(inputFunc) && logIncomingData->boolValue()) NLOGWARNING(niceName, "Worker queue is full, dropping incoming message");
+			break;
+		}
+	}
+	postInput(inputFunc); //worker not ready yet
+	break;
+
+	default:
+		postInput(inputFunc);
+		break;
+	}
+}
+
+void OSCModule::updateReceiveWorker()
+{
+	bool shouldUseWorker = processMode != nullptr && processMode->getValueDataAsEnum<ProcessMode>() == PROCESS_WORKER;
+
+	std::unique_ptr<ReceiveWorker> oldWorker;
+	{
+		const SpinLock::ScopedLockType sl(workerLock);
+		if (shouldUseWorker == (receiveWorker != nullptr)) return;
+
+		if (shouldUseWorker)
+		{
+			receiveWorker.reset(new ReceiveWorker(niceName));
+			receiveWorker->startThread();
+		}
+		else
+		{
+			oldWorker = std::move(receiveWorker);
+		}
+	}
+
+	oldWorker.reset(); //stopped outside of the lock
+}
+
 void OSCModule::setupModuleFromJSONData(var data)
 {
 	Module::setupModuleFromJSONData(data);
@@ -238,25 +423,33 @@ void OSCModule::setupZeroConf()
 
 	String nameToAdvertise;
 	int portToAdvertise = 0;
-	while (nameToAdvertise != niceName || portToAdvertise != localPort->intValue())
+	bool tcpToAdvertise = false;
+	while (nameToAdvertise != niceName || portToAdvertise != localPort->intValue() || tcpToAdvertise != isTCPInput())
 	{
 		nameToAdvertise = niceName;
 		portToAdvertise = localPort->intValue();
+		tcpToAdvertise = isTCPInput();
 
 		servus.withdraw();
+		tcpServus.withdraw();
 		
 		if (!hasInput) return;
 
 		//DBG("ADVERTISE");
-		servus.announce(portToAdvertise, ("Chataigne - " + nameToAdvertise).toStdString());
+		(tcpToAdvertise ? tcpServus : servus).announce(portToAdvertise, ("Chataigne - " + nameToAdvertise).toStdString());
 		
-		if (nameToAdvertise != niceName || localPort->intValue() != portToAdvertise || !hasInput)
+		if (nameToAdvertise != niceName || localPort->intValue() != portToAdvertise || tcpToAdvertise != isTCPInput() || !hasInput)
 		{
 			//DBG("Name or port changed during advertise, readvertising");
 		}
 	}
 	
-	NLOG(niceName,"Zeroconf service created : " << nameToAdvertise << ":" << portToAdvertise);
+	NLOG(niceName,"Zeroconf service created : " << nameToAdvertise << ":" << portToAdvertise << (tcpToAdvertise ? " (TCP)" : ""));
+}
+
+bool OSCModule::isTCPInput()
+{
+	return inputTransport != nullptr && inputTransport->getValueDataAsEnum<OSCOutput::Transport>() != OSCOutput::UDP;
 }
 
 var OSCModule::sendOSCFromScript(const var::NativeFunctionArgs & a)
@@ -294,14 +487,93 @@ var OSCModule::sendOSCFromScript(const var::NativeFunctionArgs & a)
 	return var();
 }
 
+var OSCModule::getBlobSizeFromScript(const var::NativeFunctionArgs & a)
+{
+	if (a.numArguments == 0 || !a.arguments[0].isBinaryData()) return 0;
+	return (int)a.arguments[0].getBinaryData()->getSize();
+}
+
+var OSCModule::getBlobBytesFromScript(const var::NativeFunctionArgs & a)
+{
+	//getBlobBytes(blob, start, count), start and count are optional
+	var result = var(Array<var>()); //initialize force array
+	if (a.numArguments == 0 || !a.arguments[0].isBinaryData()) return result;
+
+	const MemoryBlock &b = *a.arguments[0].getBinaryData();
+	const int size = (int)b.getSize();
+	const int start = jlimit(0, size, a.numArguments > 1 ? (int)a.arguments[1] : 0);
+	const int count = jlimit(0, size - start, a.numArguments > 2 ? (int)a.arguments[2] : size - start);
+
+	Array<var> * bytes = result.getArray();
+	bytes->ensureStorageAllocated(count);
+	const uint8 * d = (const uint8 *)b.getData() + start;
+	for (int i = 0; i < count; i++) bytes->add((int)d[i]);
+	return result;
+}
+
+var OSCModule::getBlobIntsFromScript(const var::NativeFunctionArgs & a)
+{
+	//getBlobInts(blob, offset, count, littleEndian), int32 values
+	return getBlobValuesFromScript(a, false);
+}
+
+var OSCModule::getBlobFloatsFromScript(const var::NativeFunctionArgs & a)
+{
+	//getBlobFloats(blob, offset, count, littleEndian), float32 values
+	return getBlobValuesFromScript(a, true);
+}
+
+var OSCModule::getBlobValuesFromScript(const var::NativeFunctionArgs & a, bool asFloats)
+{
+	//offset and count are optional, values are big endian by default as in OSC
+	var result = var(Array<var>()); //initialize force array
+	if (a.numArguments == 0 || !a.arguments[0].isBinaryData()) return result;
+
+	const MemoryBlock &b = *a.arguments[0].getBinaryData();
+	const int offset = jlimit(0, (int)b.getSize(), a.numArguments > 1 ? (int)a.arguments[1] : 0);
+	const int available = ((int)b.getSize() - offset) / 4;
+	const int count = jlimit(0, available, a.numArguments > 2 ? (int)a.arguments[2] : available);
+	const bool littleEndian = a.numArguments > 3 && (bool)a.arguments[3];
+
+	Array<var> * values = result.getArray();
+	values->ensureStorageAllocated(count);
+	const char * d = (const char *)b.getData() + offset;
+	for (int i = 0; i < count; i++)
+	{
+		uint32 bits = littleEndian ? ByteOrder::littleEndianInt(d + i * 4) : ByteOrder::bigEndianInt(d + i * 4);
+		if (asFloats)
+		{
+			float f;
+			memcpy(&f, &bits, 4);
+			values->add(f);
+		}
+		else values->add((int)bits);
+	}
+
+	return result;
+}
+
 
 OSCArgument OSCModule::varToArgument(const var & v)
 {
 	if (v.isBool()) return OSCArgument(((bool)v) ? 1 : 0);
 	else if (v.isInt()) return OSCArgument((int)v);
-	else if (v.isInt64()) return OSCArgument((int)v);
+	else if (v.isInt64())
+	{
+		int64 iv = (int64)v;
+		if (iv >= INT32_MIN && iv <= INT32_MAX) return OSCArgument((int)iv);
+		return OSCArgument((float)iv); //out of int32 range, keep the magnitude
+	}
 	else if (v.isDouble()) return OSCArgument((float)v);
 	else if (v.isString()) return OSCArgument(v.toString());
+	else if (v.isBinaryData()) return OSCArgument(*v.getBinaryData());
+	else if (v.isArray())
+	{
+		//array of bytes, as given to scripts for blobs
+		MemoryBlock b((size_t)v.size());
+		for (int i = 0; i < v.size(); i++) b[i] = (char)(int)v[i];
+		return OSCArgument(b);
+	}
 	jassert(false);
 	return OSCArgument("error");
 }
@@ -339,6 +611,7 @@ var OSCModule::argumentToVar(const OSCArgument & a)
 		OSCColour c = a.getColour();
 		return var((int)c.toInt32());
 	}
+	else if (a.isBlob()) return var(a.getBlob());
 	
 	return var("error");
 }
@@ -374,33 +647,44 @@ void OSCModule::loadJSONDataInternal(var data)
 	if(!isThreadRunning()) startThread();
 
 	setupReceiver();
+	updateReceiveWorker();
 }
 
 
 void OSCModule::handleRoutedModuleValue(Controllable * c, RouteParams * p)
 {
 	OSCRouteParams * op = dynamic_cast<OSCRouteParams *>(p);
-	OSCMessage m(op->address->stringValue());
-	if (c->type != Controllable::TRIGGER)
+	const ScopedLock lock(op->cachedMessage.lock);
+
+	try
 	{
-		var v = dynamic_cast<Parameter *>(c)->getValue();
+		CachedOSCMessage& m = op->cachedMessage;
+		m.begin(op->address->stringValue());
 
-		if (c->type == Parameter::COLOR)
+		if (c->type != Controllable::TRIGGER)
 		{
-			Colour col = ((ColorParameter*)p)->getColor();
-			m.addColour(OSCHelpers::getOSCColour(col));
-		}else
-		{
-			if (!v.isArray())  m.addArgument(varToArgument(v));
-		    else
+			var v = dynamic_cast<Parameter *>(c)->getValue();
+
+			if (c->type == Parameter::COLOR)
 			{
-				for (int i = 0; i < v.size(); i++) m.addArgument(varToArgument(v[i]));
+				Colour col = ((ColorParameter*)c)->getColor();
+				m.addColour(OSCHelpers::getOSCColour(col));
+			}else
+			{
+				if (!v.isArray())  m.add(varToArgument(v));
+				else
+				{
+					for (int i = 0; i < v.size(); i++) m.add(varToArgument(v[i]));
+				}
 			}
 		}
-		
-	}
 
-	sendOSC(m);
+		sendOSC(m.end());
+	}
+	catch (OSCFormatError &e)
+	{
+		NLOGERROR(niceName, "Can't route to address " << op->address->stringValue() << " : " << e.description);
+	}
 }
 
 void OSCModule::onContainerParameterChangedInternal(Parameter * p)
@@ -439,21 +723,117 @@ void OSCModule::onControllableFeedbackUpdateInternal(ControllableContainer * cc,
 	{
 		if (!isCurrentlyLoadingData) setupReceiver();
 	}
+	else if (c == inputTransport || c == multicastGroup || c == multicastInterface)
+	{
+		if (!isCurrentlyLoadingData) setupReceiver();
+	}
+	else if (c == processMode)
+	{
+		if (!isCurrentlyLoadingData) updateReceiveWorker();
+	}
+	else if (c == honorTimeTags)
+	{
+		maxTimeTagDelay->setEnabled(honorTimeTags->boolValue());
+		dropBeyondMaxDelay->setEnabled(honorTimeTags->boolValue());
+	}
 }
 
-void OSCModule::oscMessageReceived(const OSCMessage & message)
+void OSCModule::clearItem()
 {
-	if (!enabled->boolValue()) return;
-	processMessage(message);
+	disconnectReceiver();
+	if (tcpServer != nullptr) tcpServer->stop();
+	if (recorder != nullptr)
+	{
+		recorder->stopReplay();
+		recorder->stopRecording();
+	}
+
+	if (bundleScheduler != nullptr)
+	{
+		bundleScheduler->stopThread(1000);
+		bundleScheduler->clear();
+	}
+	
+	std::unique_ptr<ReceiveWorker> oldWorker;
+	{
+		const SpinLock::ScopedLockType sl(workerLock);
+		oldWorker = std::move(receiveWorker);
+	}
+	oldWorker.reset();
+
+	Module::clearItem();
 }
 
-void OSCModule::oscBundleReceived(const OSCBundle & bundle)
+void OSCModule::udpPacketReceived(const void * data, size_t size)
 {
-	if (!enabled->boolValue()) return;
-	for (auto &m : bundle)
+	packetReceived(data, size);
+}
+
+void OSCModule::tcpPacketReceived(const void * data, size_t size)
+{
+	//clients are read by their own threads, keep the processing sequential as with UDP
+	const ScopedLock lock(tcpReceiveLock);
+	packetReceived(data, size);
+}
+
+void OSCModule::tcpClientsChanged(int numClients)
+{
+	if (numTCPClients != nullptr) numTCPClients->setValue(numClients);
+}
+
+void OSCModule::handleIncomingPacket(std::shared_ptr<OSCReceivedPacket> packet)
+{
+	if (packet->isBundle && bundleScheduler != nullptr && honorTimeTags->boolValue() && !packet->timeTag.isImmediately())
+	{
+		double delay = OSCBundleScheduler::getDelayForTimeTag(packet->timeTag);
+		if (delay > 0)
+		{
+			delay = getCappedTimeTagDelay(delay);
+			if (delay < 0) return; //dropped
+
+			if (delay > 0)
+			{
+				bundleScheduler->schedule(packet, delay);
+				return;
+			}
+		}
+		else
+		{
+			bundleScheduler->numLate++;
+			lateBundles->setValue(bundleScheduler->numLate.load());
+		}
+	}
+
+	dispatchPacket(packet);
+}
+
+double OSCModule::getCappedTimeTagDelay(double delayMs)
+{
+	if (delayMs <= maxTimeTagDelay->intValue()) return delayMs;
+
+	const bool drop = dropBeyondMaxDelay->boolValue();
+	const uint32 now = Time::getMillisecondCounter();
+	if (now - lastTimeTagWarning.load() > 1000) //at most one warning per second for a sender with a wrong clock
+	{
+		lastTimeTagWarning = now;
+		NLOGWARNING(niceName, "Received a bundle tagged " << String(delayMs / 1000.0, 1) << "s in the future, more than Max Time Tag Delay, " << (drop ? "dropping it" : "processing it now"));
+	}
+
+	return drop ? -1 : 0;
+}
+
+void OSCModule::dispatchPacket(std::shared_ptr<OSCReceivedPacket> packet)
+{
+	if (packet->messages.size() > 0)
 	{
-		processMessage(m.getMessage());
+		processIncoming([this, packet]()
+		{
+			for (auto& m : packet->messages) processMessage(m);
+		});
 	}
+
+	//nested bundles have their own time tag
+	for (auto& b : packet->bundles) handleIncomingPacket(b);
 }
 
 void OSCModule::run()
@@ -495,6 +875,48 @@ OSCModule::OSCRouteParams::OSCRouteParams(Module * sourceModule, Controllable *
 
 
 
+///// RECEIVE WORKER
+
+OSCModule::ReceiveWorker::ReceiveWorker(const String &moduleName) :
+	Thread("OSC Worker " + moduleName),
+	queue(4096),
+	numDropped(0)
+{
+}
+
+OSCModule::ReceiveWorker::~ReceiveWorker()
+{
+	stopThread(1000);
+}
+
+bool OSCModule::ReceiveWorker::post(EngineInputQueue::InputFunction inputFunc)
+{
+	if (!queue.push(inputFunc))
+	{
+		numDropped++;
+		return false;
+	}
+
+	notify();
+	return true;
+}
+
+void OSCModule::ReceiveWorker::run()
+{
+	EngineInputQueue::InputFunction inputFunc;
+	while (!threadShouldExit())
+	{
+		while (queue.pop(inputFunc))
+		{
+			inputFunc();
+			if (threadShouldExit()) return;
+		}
+
+		wait(100);
+	}
+}
+
+
 ///// OSC OUTPUT
 
 OSCOutput::OSCOutput() :
@@ -510,11 +932,45 @@ OSCOutput::OSCOutput() :
 	remoteHost->setEnabled(!useLocal->boolValue());
 	remotePort = addIntParameter("Remote port", "Port on which the remote host is listening to", 9000, 1024, 65535);
 
+	transport = addEnumParameter("Transport", "UDP sends datagrams. TCP connects to the remote host and sends packets framed using SLIP (OSC 1.1) or a size prefix (OSC 1.0), without size limit.");
+	addTransportOptions(transport);
+
+	multicastInterface = addStringParameter("Multicast Interface", "When the remote host is a multicast group, the IP of the network interface to send from. Leave empty to let the system choose.", "");
+	multicastInterface->autoTrim = true;
+	multicastTTL = addIntParameter("Multicast TTL", "When the remote host is a multicast group, the number of routers the messages can go through. 1 keeps them on the local network.", 1, 1, 255);
+	multicastLoopback = addBoolParameter("Multicast Loopback", "When the remote host is a multicast group, also deliver the messages to the receivers on this machine", true);
+
+	sendMode = addEnumParameter("Send Mode", "Immediate sends each message as soon as it is created.\nBundled collects the messages during an engine tick, keeps only the last one for each address and sends them as bundles.");
+	sendMode->addOption("Immediate", IMMEDIATE)->addOption("Bundled", BUNDLED);
+	maxPacketSize = addIntParameter("Max Packet Size", "In Bundled mode, the maximum size in bytes of a sent bundle. Bundles are split to stay under this size.", 1472, 64, 65507);
+	maxPacketSize->setEnabled(false);
+
+	dropPolicy = addEnumParameter("Drop Policy", "What to do when messages are sent faster than the target receives them and the send queue is full.\nDrop Oldest discards the oldest queued message, Drop Newest discards the new one, Coalesce only keeps the latest queued message for each address.");
+	dropPolicy->addOption("Drop Oldest", OSCSendWorker::DROP_OLDEST)->addOption("Drop Newest", OSCSendWorker::DROP_NEWEST)->addOption("Coalesce", OSCSendWorker::COALESCE);
+
+	queueDepth = addIntParameter("Queue Depth", "Number of messages waiting to be sent", 0, 0);
+	queueDepth->setControllableFeedbackOnly(true);
+	queueDepth->isSavable = false;
+	droppedMessages = addIntParameter("Dropped Messages", "Number of messages dropped or coalesced because the send queue was full", 0, 0);
+	droppedMessages->setControllableFeedbackOnly(true);
+	droppedMessages->isSavable = false;
+
+	sendWorker.reset(new OSCSendWorker(niceName, [this](const OSCMessage& m) { sendPacketNow(m); }, [this](const OSCBundle& b) { sendPacketNow(b); }));
+	sendWorker->onStatsChanged = [this](int depth, int dropped)
+	{
+		queueDepth->setValue(depth);
+		droppedMessages->setValue(dropped);
+	};
+	sendWorker->startThread();
+
 	if (!Engine::mainEngine->isLoadingFile) setupSender();
 }
 
 OSCOutput::~OSCOutput()
 {
+	sendWorker.reset();
+	sender.disconnect();
+	if (EngineClock::getInstanceWithoutCreating() != nullptr) EngineClock::getInstance()->removeClockListener(this);
 }
 
 void OSCOutput::setForceDisabled(bool value)
@@ -527,11 +983,19 @@ void OSCOutput::setForceDisabled(bool value)
 void OSCOutput::onContainerParameterChangedInternal(Parameter * p)
 {
 
-	if (p == remoteHost || p == remotePort || p == useLocal)
+	if (p == remoteHost || p == remotePort || p == useLocal || p == transport || p == multicastInterface || p == multicastTTL || p == multicastLoopback)
 	{
 		if(!Engine::mainEngine->isLoadingFile) setupSender();
 		if (p == useLocal) remoteHost->setEnabled(!useLocal->boolValue());
 	}
+	else if (p == sendMode)
+	{
+		updateBundling();
+	}
+	else if (p == dropPolicy)
+	{
+		sendWorker->dropPolicy = (int)dropPolicy->getValueDataAsEnum<OSCSendWorker::DropPolicy>();
+	}
 }
 
 InspectableEditor * OSCOutput::getEditor(bool isRoot)
@@ -539,13 +1003,54 @@ InspectableEditor * OSCOutput::getEditor(bool isRoot)
 	return new OSCOutputEditor(this, isRoot);
 }
 
+void OSCOutput::addTransportOptions(EnumParameter * p)
+{
+	p->addOption("UDP", UDP)->addOption("TCP (SLIP)", TCP_SLIP)->addOption("TCP (Size Prefix)", TCP_LENGTH_PREFIX);
+}
+
 void OSCOutput::setupSender()
 {
+	sendWorker->clear();
+
+	const ScopedLock lock(senderLock);
 	sender.disconnect();
+	if (tcpSender != nullptr) tcpSender->disconnect();
 	if (!enabled->boolValue() || forceDisabled || Engine::mainEngine->isClearing) return;
 
 	String targetHost = useLocal->boolValue() ? "127.0.0.1" : remoteHost->stringValue();
-	senderIsConnected = sender.connect(targetHost, remotePort->intValue());
+
+	Transport t = transport->getValueDataAsEnum<Transport>();
+	if (t != UDP)
+	{
+		//the connection is made and retried by the sender thread, messages are queued meanwhile
+		if (tcpSender == nullptr) tcpSender.reset(new OSCTCPSender(niceName));
+		tcpSender->connect(targetHost, remotePort->intValue(), getFramingForTransport(t));
+		senderIsConnected = true;
+		NLOG(niceName, "Now sending over TCP to " + targetHost + ":" + remotePort->stringValue());
+		clearWarning();
+		return;
+	}
+
+	if (OSCMulticast::isMulticastAddress(targetHost))
+	{
+		//one datagram reaches every receiver that joined the group
+		multicastSocket.reset(new DatagramSocket(false));
+		String itf = multicastInterface->stringValue();
+		StringArray interfaces = OSCMulticast::getInterfaceAddresses();
+		if (itf.isNotEmpty() && !interfaces.contains(itf))
+		{
+			NLOGWARNING(niceName, itf + " is not the address of a network interface on this machine, letting the system choose. Available interfaces : " + interfaces.joinIntoString(", "));
+			itf = String();
+		}
+
+		if (!OSCMulticast::setupSender(*multicastSocket, itf, multicastTTL->intValue(), multicastLoopback->boolValue()))
+		{
+			NLOGWARNING(niceName, "Could not set multicast options, check the interface " + itf);
+		}
+		senderIsConnected = sender.connectToSocket(*multicastSocket, targetHost, remotePort->intValue());
+	}
+	else senderIsConnected = sender.connect(targetHost, remotePort->intValue());
+
 	if (senderIsConnected)
 	{ 
 		NLOG(niceName, "Now sending to " + remoteHost->stringValue() + ":" + remotePort->stringValue());
@@ -561,5 +1066,111 @@ void OSCOutput::setupSender()
 void OSCOutput::sendOSC(const OSCMessage & m)
 {
 	if (!enabled->boolValue() || forceDisabled || !senderIsConnected) return;
-	sender.send(m);
+
+	if (sendMode->getValueDataAsEnum<SendMode>() == BUNDLED)
+	{
+		const ScopedLock lock(bundleLock);
+		const String address = m.getAddressPattern().toString();
+		if (pendingIndex.contains(address)) pendingMessages.set(pendingIndex[address], m);
+		else
+		{
+			pendingIndex.set(address, pendingMessages.size());
+			pendingMessages.add(m);
+		}
+		return;
+	}
+
+	sendPacket(m);
+}
+
+void OSCOutput::sendPacket(const OSCMessage & m)
+{
+	sendWorker->send(m);
+}
+
+void OSCOutput::sendPacket(const OSCBundle & b)
+{
+	sendWorker->send(b);
+}
+
+void OSCOutput::sendPacketNow(const OSCMessage & m)
+{
+	const ScopedLock lock(senderLock);
+	if (tcpSender != nullptr && transport->getValueDataAsEnum<Transport>() != UDP) tcpSender->send(m);
+	else sender.send(m);
+}
+
+void OSCOutput::sendPacketNow(const OSCBundle & b)
+{
+	const ScopedLock lock(senderLock);
+	if (tcpSender != nullptr && transport->getValueDataAsEnum<Transport>() != UDP) tcpSender->send(b);
+	else sender.send(b);
+}
+
+void OSCOutput::updateBundling()
+{
+	bool bundled = sendMode->getValueDataAsEnum<SendMode>() == BUNDLED;
+	maxPacketSize->setEnabled(bundled);
+
+	if (bundled) EngineClock::getInstance()->addClockListener(this);
+	else
+	{
+		if (EngineClock::getInstanceWithoutCreating() != nullptr) EngineClock::getInstance()->removeClockListener(this);
+		flushBundle();
+	}
+}
+
+void OSCOutput::flushBundle()
+{
+	Array<OSCMessage> messages;
+	{
+		const ScopedLock lock(bundleLock);
+		if (pendingMessages.isEmpty()) return;
+		messages.swapWith(pendingMessages);
+		pendingIndex.clear();
+	}
+
+	if (!enabled->boolValue() || forceDisabled || !senderIsConnected) return;
+
+	const int maxSize = transport->getValueDataAsEnum<Transport>() == UDP ? maxPacketSize->intValue() : OSCStreamFramer::maxPacketSize; //TCP streams are not limited by the MTU
+	int start = 0;
+	while (start < messages.size())
+	{
+		OSCBundle bundle;
+		int bundleSize = 16; //"#bundle" and time tag
+		int i = start;
+		for (; i < messages.size(); i++)
+		{
+			int elementSize = 4 + getMessageSize(messages.getReference(i)); //size prefix + content
+			if (i > start && bundleSize + elementSize > maxSize) break;
+			bundle.addElement(OSCBundle::Element(messages.getReference(i)));
+			bundleSize += elementSize;
+		}
+
+		sendPacket(bundle);
+		start = i;
+	}
+}
+
+int OSCOutput::getMessageSize(const OSCMessage & m)
+{
+	//OSC strings are null terminated and padded to 4 bytes
+	auto paddedStringSize = [](int numBytes) { return (numBytes + 4) & ~3; };
+
+	int size = paddedStringSize((int)m.getAddressPattern().toString().getNumBytesAsUTF8());
+	size += paddedStringSize(m.size() + 1); //type tags, with the leading comma
+
+	for (auto &a : m)
+	{
+		if (a.isString()) size += paddedStringSize((int)a.getString().getNumBytesAsUTF8());
+		else if (a.isBlob()) size += 4 + (((int)a.getBlob().getSize() + 3) & ~3);
+		else size += 4;
+	}
+
+	return size;
+}
+
+void OSCOutput::engineTick(double)
+{
+	flushBundle();
 }
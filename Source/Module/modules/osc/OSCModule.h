@@ -11,11 +11,20 @@
 #pragma once
 
 #include "Module/Module.h"
+#include "Common/Engine/EngineClock.h"
+#include "commands/CachedOSCMessage.h"
+#include "recorder/OSCTrafficRecorder.h"
+#include "OSCBundleScheduler.h"
+#include "transport/OSCTCPTransport.h"
+#include "transport/OSCUDPReceiver.h"
+#include "transport/OSCSendWorker.h"
+#include "transport/OSCMulticast.h"
 #include "servus/servus.h"
 using namespace servus;
 
 class OSCOutput :
-	public BaseItem
+	public BaseItem,
+	public EngineClock::ClockListener
 {
 public:
 	OSCOutput();
@@ -30,10 +39,50 @@ public:
 	IntParameter * remotePort;
 	OSCSender sender;
 
+	//MULTICAST, used when the remote host is a multicast group
+	StringParameter * multicastInterface;
+	IntParameter * multicastTTL;
+	BoolParameter * multicastLoopback;
+	std::unique_ptr<DatagramSocket> multicastSocket;
+
+	//TRANSPORT
+	enum Transport { UDP, TCP_SLIP, TCP_LENGTH_PREFIX };
+	EnumParameter * transport;
+	std::unique_ptr<OSCTCPSender> tcpSender;
+
+	//SEND QUEUE
+	EnumParameter * dropPolicy;
+	IntParameter * queueDepth;
+	IntParameter * droppedMessages;
+	std::unique_ptr<OSCSendWorker> sendWorker;
+	CriticalSection senderLock; //the worker sends while the sender may be set up from another thread
+
+	static void addTransportOptions(EnumParameter * p);
+	static OSCStreamFramer::Framing getFramingForTransport(Transport t) { return t == TCP_LENGTH_PREFIX ? OSCStreamFramer::LENGTH_PREFIX : OSCStreamFramer::SLIP; }
+
+	//BUNDLING
+	enum SendMode { IMMEDIATE, BUNDLED };
+	EnumParameter * sendMode;
+	IntParameter * maxPacketSize;
+
+	CriticalSection bundleLock;
+	Array<OSCMessage> pendingMessages;
+	HashMap<String, int> pendingIndex; //address > index in pendingMessages, only the last message of each address is kept
+
 	void setForceDisabled(bool value);
 
 	virtual void setupSender();
 	void sendOSC(const OSCMessage & m);
+	void sendPacket(const OSCMessage & m); //queued to the send worker
+	void sendPacket(const OSCBundle & b);
+	void sendPacketNow(const OSCMessage & m); //called by the send worker
+	void sendPacketNow(const OSCBundle & b);
+
+	void updateBundling();
+	void flushBundle();
+	static int getMessageSize(const OSCMessage &m);
+
+	void engineTick(double deltaTime) override;
 
 	void onContainerParameterChangedInternal(Parameter * p) override;
 
@@ -42,7 +91,8 @@ public:
 
 class OSCModule :
 	public Module,
-	public OSCReceiver::Listener<OSCReceiver::RealtimeCallback>,
+	public OSCUDPReceiver::Listener,
+	public OSCTCPServer::Listener,
 	public Thread, //for zeroconf async creation (smoother when creating an OSC module)
 	public BaseManager<OSCOutput>::ManagerListener
 { 
@@ -52,29 +102,79 @@ public:
 
 
 	//RECEIVE
+	enum ProcessMode { PROCESS_DEFAULT, PROCESS_RECEIVER, PROCESS_WORKER };
 	IntParameter * localPort;
+	EnumParameter * processMode;
+	BoolParameter * honorTimeTags;
+	IntParameter * maxTimeTagDelay;
+	BoolParameter * dropBeyondMaxDelay;
+	IntParameter * lateBundles;
 	BoolParameter * isConnected;
-	OSCReceiver receiver;
+	OSCUDPReceiver receiver;
+	std::atomic<uint32> lastTimeTagWarning;
+
+	StringParameter * multicastGroup;
+	StringParameter * multicastInterface;
+	std::unique_ptr<DatagramSocket> multicastSocket;
+
+	EnumParameter * inputTransport;
+	IntParameter * numTCPClients;
+	std::unique_ptr<OSCTCPServer> tcpServer;
+	CriticalSection tcpReceiveLock;
+	std::unique_ptr<OSCBundleScheduler> bundleScheduler;
+
+	//Dedicated thread processing this module's incoming messages, so a busy input doesn't delay other modules
+	class ReceiveWorker :
+		public Thread
+	{
+	public:
+		ReceiveWorker(const String &moduleName);
+		~ReceiveWorker();
+
+		LockFreeQueue<EngineInputQueue::InputFunction> queue;
+		std::atomic<int> numDropped;
+
+		bool post(EngineInputQueue::InputFunction inputFunc);
+		void run() override;
+	};
+
+	SpinLock workerLock;
+	std::unique_ptr<ReceiveWorker> receiveWorker;
 	
 	//ZEROCONF
 	Servus servus;
+	Servus tcpServus;
 
 	std::unique_ptr<EnablingControllableContainer> receiveCC;
+	std::unique_ptr<OSCTrafficRecorder> recorder;
 	std::unique_ptr<BaseManager<OSCOutput>> outputManager;
 
 	//Script
 	const Identifier oscEventId = "oscEvent";
 	const Identifier sendOSCId = "send";
+	const Identifier getBlobSizeId = "getBlobSize";
+	const Identifier getBlobBytesId = "getBlobBytes";
+	const Identifier getBlobIntsId = "getBlobInts";
+	const Identifier getBlobFloatsId = "getBlobFloats";
 
 	//RECEIVE
+	void disconnectReceiver();
 	virtual void setupReceiver();
 	float getFloatArg(OSCArgument a);
 	int getIntArg(OSCArgument a);
 	String getStringArg(OSCArgument a);
 	Colour getColorArg(OSCArgument a);
+	double getDoubleArg(const OSCReceivedMessage &m, int index); //keeps the precision of double and int64 arguments
 
-	void processMessage(const OSCMessage & msg);
-	virtual void processMessageInternal(const OSCMessage &) {}
+	void packetReceived(const void * data, size_t size);
+	void processMessage(const OSCReceivedMessage & m);
+	virtual void processMessageInternal(const OSCReceivedMessage &) {}
+
+	void processIncoming(EngineInputQueue::InputFunction inputFunc); //dispatch incoming data depending on the process mode
+	void handleIncomingPacket(std::shared_ptr<OSCReceivedPacket> packet); //schedules future-dated bundles if time tags are honored, dispatches the others
+	void dispatchPacket(std::shared_ptr<OSCReceivedPacket> packet);
+	double getCappedTimeTagDelay(double delayMs); //the delay limited to Max Time Tag Delay, 0 to process the bundle now, negative to drop it
+	void updateReceiveWorker();
 
 	virtual void setupModuleFromJSONData(var data) override;
 
@@ -86,9 +186,15 @@ public:
 
 	//ZEROCONF
 	void setupZeroConf();
+	bool isTCPInput();
 
 	//Script
 	static var sendOSCFromScript(const var::NativeFunctionArgs &args);
+	static var getBlobSizeFromScript(const var::NativeFunctionArgs &args);
+	static var getBlobBytesFromScript(const var::NativeFunctionArgs &args);
+	static var getBlobIntsFromScript(const var::NativeFunctionArgs &args);
+	static var getBlobFloatsFromScript(const var::NativeFunctionArgs &args);
+	static var getBlobValuesFromScript(const var::NativeFunctionArgs &args, bool asFloats);
 
 
 	static OSCArgument varToArgument(const var &v);
@@ -108,16 +214,20 @@ public:
 		OSCRouteParams(Module * sourceModule, Controllable * c);
 		~OSCRouteParams() {}
 		StringParameter * address;
+		CachedOSCMessage cachedMessage;
 	};
 
+	virtual void clearItem() override;
+
 	virtual RouteParams * createRouteParamsForSourceValue(Module * sourceModule, Controllable * c, int /*index*/) override { return new OSCRouteParams(sourceModule, c); }
 	virtual void handleRoutedModuleValue(Controllable * c, RouteParams * p) override;
 
 	virtual void onContainerParameterChangedInternal(Parameter * p) override;
 	virtual void onContainerNiceNameChanged() override;
 	virtual void onControllableFeedbackUpdateInternal(ControllableContainer * cc, Controllable * c) override;
-	virtual void oscMessageReceived(const OSCMessage & message) override;
-	virtual void oscBundleReceived(const OSCBundle & bundle) override;
+	virtual void udpPacketReceived(const void * data, size_t size) override;
+	virtual void tcpPacketReceived(const void * data, size_t size) override;
+	virtual void tcpClientsChanged(int numClients) override;
 
 
 	// Inherited via Thread
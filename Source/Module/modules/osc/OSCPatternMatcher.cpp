@@ -0,0 +1,129 @@
+/*
+  ==============================================================================
+
+    OSCPatternMatcher.cpp
+    Created: 17 Oct 2026 9:48:02pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "OSCPatternMatcher.h"
+
+bool OSCPatternMatcher::isPattern(const String & address)
+{
+	return address.containsAnyOf("*?[]{}") || address.contains("//");
+}
+
+bool OSCPatternMatcher::matches(const String & pattern, const String & address)
+{
+	return matchFrom(pattern.toRawUTF8(), address.toRawUTF8());
+}
+
+bool OSCPatternMatcher::matchFrom(const char * p, const char * a)
+{
+	while (*p != 0)
+	{
+		switch (*p)
+		{
+		case '/':
+			if (p[1] == '/')
+			{
+				//path traversal, the rest of the pattern (starting with its /) can start at any part of the address
+				const char * rest = p + 1;
+				for (const char * s = a; *s != 0; s++)
+				{
+					if (*s == '/' && matchFrom(rest, s)) return true;
+				}
+				return false;
+			}
+
+			if (*a != '/') return false;
+			p++;
+			a++;
+			break;
+
+		case '*':
+		{
+			while (*p == '*') p++;
+			for (const char * s = a;; s++)
+			{
+				if (matchFrom(p, s)) return true;
+				if (*s == 0 || *s == '/') return false;
+			}
+		}
+
+		case '?':
+			if (*a == 0 || *a == '/') return false;
+			p++;
+			a++;
+			break;
+
+		case '[':
+			if (*a == 0 || *a == '/') return false;
+			p++;
+			if (!matchSet(p, *a)) return false;
+			a++;
+			break;
+
+		case '{':
+		{
+			const char * end = p + 1;
+			while (*end != 0 && *end != '}') end++;
+			if (*end == 0) return false; //unterminated
+
+			const char * next = end + 1;
+			const char * option = p + 1;
+			while (option <= end)
+			{
+				const char * optionEnd = option;
+				while (optionEnd < end && *optionEnd != ',') optionEnd++;
+
+				size_t len = (size_t)(optionEnd - option);
+				if (strncmp(option, a, len) == 0 && matchFrom(next, a + len)) return true;
+
+				option = optionEnd + 1;
+			}
+			return false;
+		}
+
+		default:
+			if (*p != *a) return false;
+			p++;
+			a++;
+			break;
+		}
+	}
+
+	return *a == 0;
+}
+
+bool OSCPatternMatcher::matchSet(const char * &p, char c)
+{
+	bool negate = false;
+	if (*p == '!')
+	{
+		negate = true;
+		p++;
+	}
+
+	bool found = false;
+	bool first = true;
+	while (*p != 0 && (*p != ']' || first))
+	{
+		first = false;
+		if (p[1] == '-' && p[2] != 0 && p[2] != ']')
+		{
+			if (c >= p[0] && c <= p[2]) found = true;
+			p += 3;
+		}
+		else
+		{
+			if (*p == c) found = true;
+			p++;
+		}
+	}
+
+	if (*p == ']') p++;
+	return found != negate;
+}
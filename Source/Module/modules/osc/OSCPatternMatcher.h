@@ -0,0 +1,28 @@
+/*
+  ==============================================================================
+
+    OSCPatternMatcher.h
+    Created: 17 Oct 2026 9:48:02pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "JuceHeader.h"
+
+/*
+	OSC 1.0 address pattern matching (*, ?, [abc], [a-z], [!abc], {foo,bar}) plus the OSC 1.1 path-traversal wildcard //,
+	which matches any number of address parts (e.g. //dim matches /dim, /fixture/dim and /fixture/1/dim).
+*/
+class OSCPatternMatcher
+{
+public:
+	static bool isPattern(const String &address);
+	static bool matches(const String &pattern, const String &address);
+
+private:
+	static bool matchFrom(const char * p, const char * a);
+	static bool matchSet(const char * &p, char c);
+};
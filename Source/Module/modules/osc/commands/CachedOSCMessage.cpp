@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+    CachedOSCMessage.cpp
+    Created: 17 Oct 2026 7:21:10pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "CachedOSCMessage.h"
+
+CachedOSCMessage::CachedOSCMessage() :
+	numArgs(0)
+{
+}
+
+CachedOSCMessage::~CachedOSCMessage()
+{
+}
+
+void CachedOSCMessage::begin(const String & address)
+{
+	if (message == nullptr || message->getAddressPattern().toString() != address)
+	{
+		message.reset(); //if the new address is invalid, the next call will try again
+		message.reset(new OSCMessage(address));
+	}
+
+	numArgs = 0;
+}
+
+void CachedOSCMessage::add(const OSCArgument & a)
+{
+	jassert(message != nullptr);
+
+	if (numArgs < message->size())
+	{
+		OSCArgument &current = (*message)[numArgs];
+		if (current.getType() == a.getType())
+		{
+			current = a;
+			numArgs++;
+			return;
+		}
+
+		truncate(numArgs);
+	}
+
+	message->addArgument(a);
+	numArgs++;
+}
+
+const OSCMessage & CachedOSCMessage::end()
+{
+	jassert(message != nullptr);
+	if (numArgs < message->size()) truncate(numArgs);
+	return *message;
+}
+
+void CachedOSCMessage::reset()
+{
+	message.reset();
+	numArgs = 0;
+}
+
+void CachedOSCMessage::truncate(int numArgsToKeep)
+{
+	std::unique_ptr<OSCMessage> m(new OSCMessage(message->getAddressPattern()));
+	for (int i = 0; i < numArgsToKeep; i++) m->addArgument((*message)[i]);
+	message = std::move(m);
+}
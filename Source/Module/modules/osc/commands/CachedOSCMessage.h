@@ -0,0 +1,47 @@
+/*
+  ==============================================================================
+
+    CachedOSCMessage.h
+    Created: 17 Oct 2026 7:21:10pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "JuceHeader.h"
+
+/*
+	Reusable OSC message for outputs that send the same layout over and over (mappings, routing).
+	The address pattern is only parsed again when the address changes, and argument values are updated in place.
+	The argument list is only rebuilt when its structure (count or types) changes.
+
+	Usage : begin(address), add() each argument, then end() to get the message to send.
+*/
+class CachedOSCMessage
+{
+public:
+	CachedOSCMessage();
+	~CachedOSCMessage();
+
+	CriticalSection lock;
+
+	void begin(const String &address); //throws OSCFormatError if the address is not valid
+	void add(const OSCArgument &a);
+	void addInt32(int v) { add(OSCArgument(v)); }
+	void addFloat32(float v) { add(OSCArgument(v)); }
+	void addString(const String &v) { add(OSCArgument(v)); }
+	void addColour(OSCColour v) { add(OSCArgument(v)); }
+	const OSCMessage &end();
+
+	void reset();
+
+private:
+	std::unique_ptr<OSCMessage> message;
+	int numArgs;
+
+	void truncate(int numArgsToKeep);
+
+	JUCE_DECLARE_NON_COPYABLE(CachedOSCMessage)
+};
@@ -122,9 +122,12 @@ void OSCCommand::triggerInternal()
 
 	BaseCommand::triggerInternal();
 
+	const ScopedLock lock(cachedMessage.lock);
+
 	try
 	{
-		OSCMessage m(address->stringValue());
+		CachedOSCMessage& m = cachedMessage;
+		m.begin(address->stringValue());
 
 		for (auto& a : argumentsContainer.controllables)
 		{
@@ -161,7 +164,7 @@ void OSCCommand::triggerInternal()
 			}
 		}
 
-		oscModule->sendOSC(m);
+		oscModule->sendOSC(m.end());
 	}
 	catch (OSCFormatError& e)
 	{
@@ -11,6 +11,7 @@
 #pragma once
 
 #include "Common/Command/BaseCommand.h"
+#include "CachedOSCMessage.h"
 
 class OSCModule;
 
@@ -28,6 +29,8 @@ public:
 	String addressModel;
 	bool rebuildAddressOnParamChanged;
 
+	CachedOSCMessage cachedMessage;
+
 	virtual void rebuildAddress();
 	void buildArgsAndParamsFromData(var data);
 
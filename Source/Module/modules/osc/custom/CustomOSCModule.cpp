@@ -25,39 +25,277 @@ CustomOSCModule::CustomOSCModule() :
 
 	valuesCC.userCanAddControllables = true;
 	valuesCC.customUserCreateControllableFunc = &CustomOSCModule::showMenuAndCreateValue;
+
+	setupInputConflation();
 	
 	
 }
 
-void CustomOSCModule::processMessageInternal(const OSCMessage & msg)
+Controllable * CustomOSCModule::getValueForAddress(const String & address, int argIndex)
+{
+	//values are found by their short name, the address with its slashes replaced by underscores
+	const String key = address.replaceCharacters("/", "_");
+	{
+		const SpinLock::ScopedLockType sl(addressIndexLock);
+		if (AddressEntry * e = addressIndex[key])
+		{
+			Controllable * c = argIndex < 0 ? e->target : e->argTargets[argIndex];
+			if (c != nullptr) return c;
+		}
+	}
+
+	//not indexed, e.g. a short name changed without a structure change, the container search finds it and it is indexed again
+	Controllable * c = valuesCC.getControllableByName(argIndex < 0 ? key : key + " " + String(argIndex));
+	if (c != nullptr)
+	{
+		unindexValue(c);
+		indexValue(c);
+	}
+
+	return c;
+}
+
+String CustomOSCModule::getBaseAddress(const String & name, int & argIndex)
+{
+	//split arguments are named "/address 0", "/address 1"... and their short names "_address 0", "_address 1"...
+	argIndex = -1;
+	const int spaceIndex = name.lastIndexOfChar(' ');
+	if (spaceIndex <= 0 || name.length() - spaceIndex > 4) return name;
+
+	const String suffix = name.substring(spaceIndex + 1);
+	if (suffix.isEmpty() || !suffix.containsOnly("0123456789")) return name;
+
+	argIndex = suffix.getIntValue();
+	return name.substring(0, spaceIndex);
+}
+
+void CustomOSCModule::indexValue(Controllable * c)
+{
+	int argIndex = -1;
+	const String key = getBaseAddress(c->shortName, argIndex);
+	int niceArgIndex = -1;
+	const String address = getBaseAddress(c->niceName, niceArgIndex);
+
+	const SpinLock::ScopedLockType sl(addressIndexLock);
+
+	AddressEntry * e = addressIndex[key];
+	if (e == nullptr)
+	{
+		e = addressEntries.add(new AddressEntry());
+		e->address = address;
+		addressIndex.set(key, e);
+	}
+
+	if (argIndex < 0) e->target = c;
+	else
+	{
+		while (e->argTargets.size() <= argIndex) e->argTargets.add(nullptr);
+		e->argTargets.set(argIndex, c);
+	}
+
+	indexedNames.set(c, c->shortName);
+
+	patternIndex.clear();
+	patternEntries.clear();
+}
+
+void CustomOSCModule::unindexValue(Controllable * c)
+{
+	const SpinLock::ScopedLockType sl(addressIndexLock);
+	if (!indexedNames.contains(c)) return;
+
+	int argIndex = -1;
+	const String key = getBaseAddress(indexedNames[c], argIndex);
+	indexedNames.remove(c);
+
+	patternIndex.clear();
+	patternEntries.clear();
+
+	AddressEntry * e = addressIndex[key];
+	if (e == nullptr) return;
+
+	if (argIndex < 0 && e->target == c) e->target = nullptr;
+	else if (argIndex >= 0 && e->argTargets[argIndex] == c) e->argTargets.set(argIndex, nullptr);
+
+	if (e->target != nullptr) return;
+	for (auto &t : e->argTargets) if (t != nullptr) return;
+
+	addressIndex.remove(key);
+	addressEntries.removeObject(e);
+}
+
+void CustomOSCModule::rebuildAddressIndex()
+{
+	clearAddressIndex();
+	for (auto &c : valuesCC.controllables) indexValue(c);
+}
+
+void CustomOSCModule::clearAddressIndex()
+{
+	const SpinLock::ScopedLockType sl(addressIndexLock);
+	addressIndex.clear();
+	addressEntries.clear();
+	indexedNames.clear();
+	patternIndex.clear();
+	patternEntries.clear();
+}
+
+void CustomOSCModule::controllableAdded(Controllable * c)
+{
+	OSCModule::controllableAdded(c);
+	if (c->parentContainer == &valuesCC) indexValue(c);
+}
+
+void CustomOSCModule::controllableRemoved(Controllable * c)
+{
+	OSCModule::controllableRemoved(c);
+	unindexValue(c);
+}
+
+void CustomOSCModule::childStructureChanged(ControllableContainer * cc)
+{
+	OSCModule::childStructureChanged(cc);
+	if (cc != &valuesCC) return;
+
+	//a value has been renamed, its address changed
+	Array<Controllable *> renamedValues;
+	{
+		const SpinLock::ScopedLockType sl(addressIndexLock);
+		for (auto &c : valuesCC.controllables)
+		{
+			if (!indexedNames.contains(c) || indexedNames[c] != c->shortName) renamedValues.add(c);
+		}
+	}
+
+	for (auto &c : renamedValues)
+	{
+		unindexValue(c);
+		indexValue(c);
+	}
+}
+
+void CustomOSCModule::getValuesForPattern(const String & pattern, Array<PatternTarget> &result)
+{
+	const SpinLock::ScopedLockType sl(addressIndexLock);
+
+	if (PatternEntry * e = patternIndex[pattern])
+	{
+		result.addArray(e->targets);
+		return;
+	}
+
+	if (patternEntries.size() >= 1024)
+	{
+		patternIndex.clear();
+		patternEntries.clear();
+	}
+
+	PatternEntry * e = patternEntries.add(new PatternEntry());
+	for (auto &a : addressEntries)
+	{
+		if (!OSCPatternMatcher::matches(pattern, a->address)) continue;
+		if (a->target != nullptr) e->targets.add({ a->target, -1 });
+		for (int i = 0; i < a->argTargets.size(); i++) if (a->argTargets[i] != nullptr) e->targets.add({ a->argTargets[i], i });
+	}
+
+	patternIndex.set(pattern, e);
+	result.addArray(e->targets);
+}
+
+void CustomOSCModule::setValueFromMessage(Controllable * c, const OSCReceivedMessage & m)
+{
+	const OSCMessage &msg = m.message;
+	if (c->type != Controllable::TRIGGER) ((Parameter *)c)->autoAdaptRange = true;
+
+	switch (c->type)
+	{
+	case Controllable::TRIGGER:
+		setInputValue(c, var());
+		break;
+
+	case Controllable::BOOL: 
+		if (msg.size() >= 1) setInputValue(c, getFloatArg(msg[0]) >= 1);
+		break;
+
+	case Controllable::FLOAT:
+		if (msg.size() >= 1) setInputValue(c, getDoubleArg(m, 0));
+		break;
+
+	case Controllable::INT:
+		if (msg.size() >= 1) setInputValue(c, getIntArg(msg[0]));
+		break;
+
+	case Controllable::STRING:
+		if (msg.size() >= 1) setInputValue(c, getStringArg(msg[0]));
+		break;
+
+	case Controllable::POINT2D:
+		if (msg.size() >= 2) setInputValue(c, Array<var>(getDoubleArg(m, 0), getDoubleArg(m, 1)));
+		break;
+
+	case Controllable::POINT3D:
+		if (msg.size() >= 3) setInputValue(c, Array<var>(getDoubleArg(m, 0), getDoubleArg(m, 1), getDoubleArg(m, 2)));
+		break;
+
+	case Controllable::COLOR:
+		if (msg.size() >= 3)
+		{
+			Colour col((uint8)(getFloatArg(msg[0]) * 255), (uint8)(getFloatArg(msg[1]) * 255), (uint8)(getFloatArg(msg[2]) * 255), msg.size() >= 4 ? getFloatArg(msg[3]) : 1);
+			setInputValue(c, Array<var>(col.getFloatRed(), col.getFloatGreen(), col.getFloatBlue(), col.getFloatAlpha()));
+		}
+		break;
+
+	default:
+		//not handled
+		break;
+	}
+}
+
+void CustomOSCModule::setValueFromArgument(Controllable * c, const OSCReceivedMessage & m, int index)
+{
+	const OSCArgument &a = m.message[index];
+	switch (c->type)
+	{
+	case Controllable::BOOL: setInputValue(c, getFloatArg(a) >= 1); break;
+	case Controllable::FLOAT: setInputValue(c, getDoubleArg(m, index)); break;
+	case Controllable::INT: setInputValue(c, getIntArg(a)); break;
+	case Controllable::STRING: setInputValue(c, getStringArg(a)); break;
+	default:
+		break;
+	}
+}
+
+void CustomOSCModule::processMessageInternal(const OSCReceivedMessage & m)
 {
 	if (autoAdd == nullptr) return;
 
-	//first we remove slashes to allow for simple controllableContainer search
+	const OSCMessage &msg = m.message;
+
 	const String cNiceName = msg.getAddressPattern().toString();
-	const String cShortName = cNiceName.replaceCharacters("/", "_");
 	Controllable * c = nullptr;
 
+	if (msg.getAddressPattern().containsWildcards() || OSCPatternMatcher::isPattern(cNiceName)) //pattern, applied to all matching values, never auto added
+	{
+		Array<PatternTarget> targets;
+		getValuesForPattern(cNiceName, targets);
+		for (auto &t : targets)
+		{
+			if (t.argIndex < 0) setValueFromMessage(t.target, m);
+			else if (t.argIndex < msg.size()) setValueFromArgument(t.target, m, t.argIndex);
+		}
+		return;
+	}
+
 
 	if(msg.size() > 1 && splitArgs->boolValue()) // Split args on multi type
 	{
 		for (int i = 0; i < msg.size(); i++) 
 		{
-			c = valuesCC.getControllableByName(cShortName+" "+String(i));
-			Parameter * p = (Parameter *)c;
-			if (c != nullptr) //Args already exists
-			{
-				switch (c->type)
-				{
-				case Controllable::BOOL: p->setValue(getFloatArg(msg[i]) >= 1); break;
-				case Controllable::FLOAT: p->setValue(getFloatArg(msg[i]));break;
-				case Controllable::INT: p->setValue(getIntArg(msg[i])); break;
-				case Controllable::STRING: p->setValue(getStringArg(msg[i])); break;
-                    default:
-                        break;
-				}
-			} else if(autoAdd->boolValue())//Args don't exist yet
+			c = getValueForAddress(cNiceName, i);
+			if (c != nullptr) setValueFromArgument(c, m, i); //Args already exists
+			else if(autoAdd->boolValue())//Args don't exist yet
 			{
+				const String cShortName = cNiceName.replaceCharacters("/", "_");
 				String argIAddress = cNiceName + " " + String(i);
 				if (msg[i].isInt32())
 				{
@@ -65,8 +303,9 @@ void CustomOSCModule::processMessageInternal(const OSCMessage & msg)
 					else c = valuesCC.addIntParameter(argIAddress, "", msg[i].getInt32());
 				} else if (msg[i].isFloat32())
 				{
-					if (autoRange->boolValue()) c = valuesCC.addFloatParameter(argIAddress, "", msg[i].getFloat32(), msg[i].getFloat32(), msg[i].getFloat32());
-					else c = valuesCC.addFloatParameter(argIAddress, "", msg[i].getFloat32());
+					const double v = getDoubleArg(m, i); //float, double or int64 out of the int32 range
+					if (autoRange->boolValue()) c = valuesCC.addFloatParameter(argIAddress, "", v, v, v);
+					else c = valuesCC.addFloatParameter(argIAddress, "", v);
 				} else if (msg[i].isString()) c = valuesCC.addStringParameter(argIAddress, "", msg[i].getString());
 
 
@@ -83,60 +322,10 @@ void CustomOSCModule::processMessageInternal(const OSCMessage & msg)
 		}
 	} else //Standard handling of incoming messages
 	{
-		c = valuesCC.getControllableByName(cShortName);
+		c = getValueForAddress(cNiceName);
 
 		
-		if (c != nullptr) //update existing controllable
-		{
-			if (c->type != Controllable::TRIGGER) ((Parameter *)c)->autoAdaptRange = true;
-
-			switch (c->type)
-			{
-			case Controllable::TRIGGER:
-				((Trigger *)c)->trigger();
-				break;
-
-			case Controllable::BOOL: 
-				((Parameter *)c)->setValue(getFloatArg(msg[0]) >= 1); break;
-				break;
-
-			case Controllable::FLOAT:
-				if (msg.size() >= 1)
-				{
-					FloatParameter *f = (FloatParameter *)c;
-					f->setValue(getFloatArg(msg[0]));
-				}
-				break;
-
-			case Controllable::INT:
-				if (msg.size() >= 1)
-				{
-					IntParameter *i = (IntParameter *)c;
-					i->setValue(getIntArg(msg[0]));
-				}
-				break;
-
-			case Controllable::STRING:
-				if (msg.size() >= 1) ((StringParameter *)c)->setValue(getStringArg(msg[0]));
-				break;
-
-			case Controllable::POINT2D:
-				if (msg.size() >= 2) ((Point2DParameter *)c)->setPoint(getFloatArg(msg[0]), getFloatArg(msg[1]));
-				break;
-
-			case Controllable::POINT3D:
-				if (msg.size() >= 3) ((Point3DParameter *)c)->setVector(Vector3D<float>(getFloatArg(msg[0]), getFloatArg(msg[1]), getFloatArg(msg[2])));
-				break;
-
-			case Controllable::COLOR:
-				if (msg.size() >= 3) ((ColorParameter *)c)->setColor(Colour((uint8)(getFloatArg(msg[0]) * 255), (uint8)(getFloatArg(msg[1]) * 255), (uint8)(getFloatArg(msg[2]) * 255), msg.size() >= 4?getFloatArg(msg[3]):1));
-				break;
-
-			default:
-				//not handled
-				break;
-			}
-		}
+		if (c != nullptr) setValueFromMessage(c, m); //update existing controllable
 	}
 
 
@@ -160,8 +349,9 @@ void CustomOSCModule::processMessageInternal(const OSCMessage & msg)
 				else  c = new IntParameter(cNiceName, "", msg[0].getInt32());
 			} else if (msg[0].isFloat32())
 			{
-				if (autoRange->boolValue()) c = new FloatParameter(cNiceName, "", msg[0].getFloat32(), msg[0].getFloat32(), msg[0].getFloat32());
-				else c = new FloatParameter(cNiceName, "", msg[0].getFloat32());
+				const double v = getDoubleArg(m, 0); //float, double or int64 out of the int32 range
+				if (autoRange->boolValue()) c = new FloatParameter(cNiceName, "", v, v, v);
+				else c = new FloatParameter(cNiceName, "", v);
 			} else if (msg[0].isString()) c = new StringParameter(cNiceName, "", msg[0].getString());
 
 			break;
@@ -213,6 +403,7 @@ void CustomOSCModule::processMessageInternal(const OSCMessage & msg)
 		
 		if (c != nullptr)
 		{
+			const String cShortName = cNiceName.replaceCharacters("/", "_");
 			c->setCustomShortName(cShortName); //force safeName for search
 			c->isCustomizableByUser = true;
 			c->isRemovableByUser = true;
@@ -313,4 +504,16 @@ void CustomOSCModule::setupModuleFromJSONData(var data)
 	autoAdd->setValue(false);
 	autoAdd->hideInEditor = true;
 	splitArgs->hideInEditor = true;
+}
+
+void CustomOSCModule::loadJSONDataInternal(var data)
+{
+	OSCModule::loadJSONDataInternal(data);
+	rebuildAddressIndex();
+}
+
+void CustomOSCModule::clearItem()
+{
+	OSCModule::clearItem();
+	clearAddressIndex();
 }
\ No newline at end of file
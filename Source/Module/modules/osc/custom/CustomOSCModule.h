@@ -11,6 +11,7 @@
 #pragma once
 
 #include "../OSCModule.h"
+#include "../OSCPatternMatcher.h"
 
 class CustomOSCModule :
 	public OSCModule
@@ -24,7 +25,52 @@ public:
 	BoolParameter * autoRange;
 	BoolParameter * autoFeedback;
 
-	void processMessageInternal(const OSCMessage &msg) override;
+	//Address index, values are indexed by their short name (the OSC address with "/" replaced by "_") when they are added, removed or renamed,
+	//so an incoming message is a single lookup. Split arguments ("_address 0") are stored on their base address.
+	struct AddressEntry
+	{
+		String address; //OSC address of the value, matched by address patterns
+		Controllable * target = nullptr;
+		Array<Controllable *> argTargets;
+	};
+
+	SpinLock addressIndexLock;
+	OwnedArray<AddressEntry> addressEntries;
+	HashMap<String, AddressEntry *> addressIndex;
+	HashMap<Controllable *, String> indexedNames; //short name each value is indexed with
+
+	Controllable * getValueForAddress(const String &address, int argIndex = -1);
+	static String getBaseAddress(const String &name, int &argIndex);
+	void indexValue(Controllable * c);
+	void unindexValue(Controllable * c);
+	void rebuildAddressIndex();
+	void clearAddressIndex();
+
+	void controllableAdded(Controllable * c) override;
+	void controllableRemoved(Controllable * c) override;
+	void childStructureChanged(ControllableContainer * cc) override;
+
+	//Pattern cache, the values matched by an address pattern are kept until a value is added, removed or renamed.
+	//Patterns are matched against base addresses, so split arguments keep the index of their argument.
+	struct PatternTarget
+	{
+		Controllable * target;
+		int argIndex;
+	};
+
+	struct PatternEntry
+	{
+		Array<PatternTarget> targets;
+	};
+
+	OwnedArray<PatternEntry> patternEntries;
+	HashMap<String, PatternEntry *> patternIndex;
+
+	void getValuesForPattern(const String &pattern, Array<PatternTarget> &result);
+	void setValueFromMessage(Controllable * c, const OSCReceivedMessage &m);
+	void setValueFromArgument(Controllable * c, const OSCReceivedMessage &m, int index);
+
+	void processMessageInternal(const OSCReceivedMessage &m) override;
 
 	void onControllableFeedbackUpdateInternal(ControllableContainer * cc, Controllable * c) override;
 
@@ -34,6 +80,8 @@ public:
 	virtual String getDefaultTypeString() const override { return "OSC"; }
 
 	virtual void setupModuleFromJSONData(var data) override;
+	virtual void loadJSONDataInternal(var data) override;
+	virtual void clearItem() override;
 
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CustomOSCModule)
 };
@@ -36,11 +36,12 @@ void CustomOSCCommand::triggerInternal()
 	
 	BaseCommand::triggerInternal();
 
-	String addString = address->stringValue();
-	
+	const ScopedLock lock(cachedMessage.lock);
+
 	try
 	{
-		OSCMessage m(address->stringValue());
+		CachedOSCMessage& m = cachedMessage;
+		m.begin(address->stringValue());
 
 		for (auto &a : customValuesManager->items)
 		{
@@ -78,7 +79,7 @@ void CustomOSCCommand::triggerInternal()
 
 			}
 		}
-        oscModule->sendOSC(m);
+        oscModule->sendOSC(m.end());
 	}catch (const OSCFormatError &)
 	{
 		NLOG("OSC", "Address is invalid :\n" << address->stringValue());
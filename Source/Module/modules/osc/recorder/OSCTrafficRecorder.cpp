@@ -0,0 +1,331 @@
+/*
+  ==============================================================================
+
+    OSCTrafficRecorder.cpp
+    Created: 17 Oct 2026 8:12:45pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "OSCTrafficRecorder.h"
+#include "../OSCModule.h"
+
+OSCTrafficRecorder::OSCTrafficRecorder(OSCModule * module) :
+	ControllableContainer("Recorder"),
+	Thread("OSC Replay"),
+	module(module),
+	isRecording(false),
+	recordStartTicks(0),
+	numRecordedPackets(0)
+{
+	captureFile = addFileParameter("Capture File", "The file to record incoming packets to, or to replay them from");
+	record = addBoolParameter("Record", "When checked, all incoming packets are recorded to the capture file. A new recording replaces the file content.", false);
+	record->isSavable = false;
+	replaySpeed = addFloatParameter("Replay Speed", "Speed multiplier of the replay, 1 is the recorded pace. 0 replays as fast as possible.", 1, 0, 100);
+	replayTrigger = addTrigger("Replay", "Replay the capture file into this module");
+	stopReplayTrigger = addTrigger("Stop Replay", "Stop the current replay");
+
+	numRecorded = addIntParameter("Recorded Packets", "Number of packets recorded in the current recording", 0, 0);
+	numRecorded->setControllableFeedbackOnly(true);
+	numRecorded->isSavable = false;
+	replayProgress = addFloatParameter("Replay Progress", "Progression of the current replay", 0, 0, 1);
+	replayProgress->setControllableFeedbackOnly(true);
+	replayProgress->isSavable = false;
+}
+
+OSCTrafficRecorder::~OSCTrafficRecorder()
+{
+	stopThread(1000);
+	stopRecording();
+}
+
+void OSCTrafficRecorder::startRecording()
+{
+	stopRecording();
+
+	File f = captureFile->getFile();
+	if (captureFile->stringValue().isEmpty() || f.isDirectory())
+	{
+		NLOGWARNING(module->niceName, "Choose a capture file before recording");
+		record->setValue(false);
+		return;
+	}
+
+	f.deleteFile();
+	std::unique_ptr<FileOutputStream> fs(new FileOutputStream(f));
+	if (fs->failedToOpen())
+	{
+		NLOGERROR(module->niceName, "Could not open capture file " << f.getFullPathName() << " : " << fs->getStatus().getErrorMessage());
+		record->setValue(false);
+		return;
+	}
+
+	fs->write("OSCR", 4);
+	fs->writeInt(fileVersion);
+
+	const ScopedLock lock(recordLock);
+	fs->writeInt64(Time::currentTimeMillis());
+	recordStream = std::move(fs);
+	recordStartTicks = Time::getHighResolutionTicks();
+	numRecordedPackets = 0;
+	isRecording = true;
+
+	NLOG(module->niceName, "Recording incoming packets to " << f.getFullPathName());
+}
+
+void OSCTrafficRecorder::stopRecording()
+{
+	const ScopedLock lock(recordLock);
+	if (recordStream == nullptr) return;
+
+	isRecording = false;
+	recordStream->flush();
+	recordStream.reset();
+
+	if (module != nullptr) NLOG(module->niceName, "Recording stopped, " << numRecordedPackets << " packets recorded");
+	numRecorded->setValue(numRecordedPackets);
+}
+
+void OSCTrafficRecorder::recordPacket(const void * data, size_t size)
+{
+	int64 ticks = Time::getHighResolutionTicks();
+
+	const ScopedLock lock(recordLock);
+	if (recordStream == nullptr) return;
+
+	int64 timestamp = (ticks - recordStartTicks) * 1000000 / Time::getHighResolutionTicksPerSecond();
+	recordStream->writeInt64(timestamp);
+	recordStream->writeInt((int)size);
+	recordStream->write(data, size);
+
+	numRecordedPackets++;
+}
+
+bool OSCTrafficRecorder::startReplay()
+{
+	stopReplay();
+
+	if (!captureFile->getFile().existsAsFile())
+	{
+		finishReplay(false, "Capture file " + captureFile->getFile().getFullPathName() + " doesn't exist");
+		return false;
+	}
+
+	if (record->boolValue()) record->setValue(false);
+	startThread();
+	return true;
+}
+
+void OSCTrafficRecorder::stopReplay()
+{
+	stopThread(1000);
+}
+
+void OSCTrafficRecorder::dispatchReplayPacket(const ReplayPacket & p, std::shared_ptr<ReplayStats> stats)
+{
+	if (!module->enabled->boolValue()) return;
+
+	stats->numDispatched++;
+
+	OSCModule * m = module;
+	std::shared_ptr<OSCReceivedPacket> packet = p.packet;
+	const int64 dueTicks = p.dueTicks;
+	module->processIncoming([m, packet, dueTicks, stats]()
+	{
+		processReplayedPacket(m, *packet);
+		stats->addLatency((Time::getHighResolutionTicks() - dueTicks) * 1000.0 / Time::getHighResolutionTicksPerSecond());
+		stats->numProcessed++;
+	});
+}
+
+void OSCTrafficRecorder::processReplayedPacket(OSCModule * module, const OSCReceivedPacket & packet)
+{
+	for (auto &m : packet.messages) module->processMessage(m);
+	for (auto &b : packet.bundles) processReplayedPacket(module, *b);
+}
+
+void OSCTrafficRecorder::ReplayStats::addLatency(double latency)
+{
+	const ScopedLock lock(latencyLock);
+	numLatencies++;
+	maxLatency = jmax(maxLatency, latency);
+
+	if (latencies.size() < maxLatencySamples)
+	{
+		latencies.add(latency);
+		return;
+	}
+
+	//reservoir sampling, the kept samples stay representative of the whole replay
+	int64 index = (int64)(random.nextDouble() * numLatencies);
+	if (index < maxLatencySamples) latencies.set((int)index, latency);
+}
+
+String OSCTrafficRecorder::getReplayReport(ReplayStats &stats, double elapsedSeconds, int numInvalid)
+{
+	Array<double> sorted;
+	double maxLatency = 0;
+	{
+		const ScopedLock lock(stats.latencyLock);
+		sorted = stats.latencies;
+		maxLatency = stats.maxLatency;
+	}
+	sorted.sort();
+
+	auto percentile = [&sorted](double pct) { return sorted.isEmpty() ? 0.0 : sorted[jmin(sorted.size() - 1, (int)(sorted.size() * pct / 100.0))]; };
+
+	const int numProcessed = stats.numProcessed.load();
+	String s = "Replayed " + String(numProcessed) + " / " + String(stats.numDispatched.load()) + " packets in " + String(elapsedSeconds, 3) + "s";
+	if (elapsedSeconds > 0) s += " (" + String(numProcessed / elapsedSeconds, 0) + " packets/s)";
+	if (numInvalid > 0) s += ", " + String(numInvalid) + " invalid packets skipped";
+	s += "\nProcessing latency : p50 " + String(percentile(50), 3) + "ms, p95 " + String(percentile(95), 3) + "ms, p99 " + String(percentile(99), 3) + "ms, max " + String(maxLatency, 3) + "ms";
+	return s;
+}
+
+void OSCTrafficRecorder::finishReplay(bool success, const String & report)
+{
+	if (success) NLOG(module->niceName, report);
+	else NLOGERROR(module->niceName, report);
+
+	if (onReplayFinished != nullptr) onReplayFinished(success, report);
+}
+
+void OSCTrafficRecorder::onContainerParameterChanged(Parameter * p)
+{
+	if (p == record)
+	{
+		if (record->boolValue()) startRecording();
+		else stopRecording();
+	}
+}
+
+void OSCTrafficRecorder::onContainerTriggerTriggered(Trigger * t)
+{
+	if (t == replayTrigger) startReplay();
+	else if (t == stopReplayTrigger) stopReplay();
+}
+
+void OSCTrafficRecorder::run()
+{
+	File f = captureFile->getFile();
+	MemoryMappedFile mmf(f, MemoryMappedFile::readOnly);
+	if (mmf.getData() == nullptr || mmf.getSize() < headerSize)
+	{
+		finishReplay(false, "Could not read capture file " + f.getFullPathName());
+		return;
+	}
+
+	const char * data = (const char *)mmf.getData();
+	const int64 dataSize = (int64)mmf.getSize();
+	MemoryInputStream is(data, (size_t)dataSize, false);
+
+	char magic[4];
+	is.read(magic, 4);
+	int version = is.readInt();
+	if (String(magic, 4) != "OSCR" || version != fileVersion)
+	{
+		finishReplay(false, f.getFullPathName() + " is not a valid capture file");
+		return;
+	}
+
+	const int64 recordStartMillis = is.readInt64();
+
+	std::shared_ptr<ReplayStats> stats(new ReplayStats());
+	const double speed = replaySpeed->floatValue();
+	const bool honorTimeTags = module->honorTimeTags != nullptr && module->honorTimeTags->boolValue();
+	const double ticksPerSecond = (double)Time::getHighResolutionTicksPerSecond();
+	const int64 startTicks = Time::getHighResolutionTicks();
+
+	NLOG(module->niceName, "Replaying " << f.getFileName() << (speed > 0 ? " at " + String(speed) + "x" : String(" at max speed")));
+
+	//packets are read when their recorded arrival time comes, and dispatched when they are due (later for bundles tagged in the future)
+	Array<ReplayPacket> pending;
+	DueTicksComparator comparator;
+	int64 order = 0;
+	int numInvalid = 0;
+
+	while (!threadShouldExit())
+	{
+		const int64 now = Time::getHighResolutionTicks();
+		int64 nextArrivalTicks = -1;
+
+		while (is.getNumBytesRemaining() >= 12 && pending.size() < 1024)
+		{
+			const int64 recordPosition = is.getPosition();
+			const int64 timestamp = is.readInt64();
+			const int64 arrivalTicks = speed > 0 ? startTicks + (int64)(timestamp / 1000000.0 / speed * ticksPerSecond) : now;
+			if (arrivalTicks > now)
+			{
+				is.setPosition(recordPosition);
+				nextArrivalTicks = arrivalTicks;
+				break;
+			}
+
+			int size = is.readInt();
+			if (size < 0 || size > is.getNumBytesRemaining())
+			{
+				is.setPosition(dataSize); //truncated record, the end of the file can't be trusted
+				break;
+			}
+
+			const char * packetData = data + is.getPosition();
+			is.skipNextBytes(size);
+
+			std::shared_ptr<OSCReceivedPacket> packet;
+			try
+			{
+				packet = OSCPacketCodec::decodePacket(packetData, (size_t)size);
+			}
+			catch (OSCFormatError &)
+			{
+				numInvalid++;
+				continue;
+			}
+
+			int64 dueTicks = arrivalTicks;
+			if (honorTimeTags && speed > 0 && packet->isBundle && !packet->timeTag.isImmediately())
+			{
+				//time tags are replayed relative to the recorded arrival
+				double tagMillis = OSCBundleScheduler::getDelayForTimeTag(packet->timeTag) + (double)Time::currentTimeMillis();
+				double delayMs = tagMillis - (recordStartMillis + timestamp / 1000.0);
+				if (delayMs > 0)
+				{
+					delayMs = module->getCappedTimeTagDelay(delayMs);
+					if (delayMs < 0) continue; //dropped, as it would have been live
+					dueTicks += (int64)(delayMs / 1000.0 / speed * ticksPerSecond);
+				}
+			}
+
+			pending.addSorted(comparator, { dueTicks, order++, packet });
+		}
+
+		while (pending.size() > 0 && pending.getReference(0).dueTicks <= Time::getHighResolutionTicks())
+		{
+			dispatchReplayPacket(pending.getReference(0), stats);
+			pending.remove(0);
+		}
+
+		if ((stats->numDispatched & 255) == 0) replayProgress->setValue(is.getPosition() * 1.0 / dataSize);
+
+		if (pending.isEmpty() && nextArrivalTicks < 0 && is.getNumBytesRemaining() < 12) break;
+
+		int64 wakeTicks = nextArrivalTicks;
+		if (pending.size() > 0 && (wakeTicks < 0 || pending.getReference(0).dueTicks < wakeTicks)) wakeTicks = pending.getReference(0).dueTicks;
+		if (wakeTicks < 0) continue;
+
+		double msToWait = (wakeTicks - Time::getHighResolutionTicks()) * 1000.0 / ticksPerSecond;
+		if (msToWait > 2) wait(jmin((int)msToWait - 1, 100));
+		else if (msToWait > 0) Thread::yield();
+	}
+
+	//let the processing thread finish with what has been dispatched
+	for (int i = 0; i < 200 && stats->numProcessed < stats->numDispatched && !threadShouldExit(); i++) wait(10);
+
+	const bool stopped = threadShouldExit();
+	double elapsed = (Time::getHighResolutionTicks() - startTicks) / ticksPerSecond;
+	String report = getReplayReport(*stats, elapsed, numInvalid);
+	replayProgress->setValue(stopped ? 0 : 1);
+
+	finishReplay(!stopped, stopped ? "Replay stopped\n" + report : report);
+}
@@ -0,0 +1,109 @@
+/*
+  ==============================================================================
+
+    OSCTrafficRecorder.h
+    Created: 17 Oct 2026 8:12:45pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../transport/OSCPacketCodec.h"
+
+class OSCModule;
+
+/*
+	Records the packets received by an OSC module to a binary capture file, and replays them into the same module.
+	Packets are recorded as received, so bundles keep their structure and time tags.
+	Replay goes through the module's processing path (process mode, engine thread, scripts..) without using the socket,
+	at the recorded pace multiplied by Replay Speed, or as fast as possible if Replay Speed is 0.
+	If the module honors time tags, replayed bundles are delayed by as much as their time tag was ahead of their recorded arrival.
+
+	Capture file layout, little endian, only appended to while recording :
+	header : "OSCR" + int32 version + int64 start of the recording in milliseconds since 1970
+	records : int64 timestamp in microseconds since the start of the recording, int32 packet size, the OSC packet
+*/
+class OSCTrafficRecorder :
+	public ControllableContainer,
+	public Thread
+{
+public:
+	OSCTrafficRecorder(OSCModule * module);
+	~OSCTrafficRecorder();
+
+	static const int fileVersion = 2;
+	static const int headerSize = 16;
+	static const int maxLatencySamples = 100000;
+
+	OSCModule * module;
+
+	FileParameter * captureFile;
+	BoolParameter * record;
+	FloatParameter * replaySpeed;
+	Trigger * replayTrigger;
+	Trigger * stopReplayTrigger;
+	IntParameter * numRecorded;
+	FloatParameter * replayProgress;
+
+	//Record
+	std::atomic<bool> isRecording;
+	CriticalSection recordLock;
+	std::unique_ptr<FileOutputStream> recordStream;
+	int64 recordStartTicks;
+	int numRecordedPackets;
+
+	void startRecording();
+	void stopRecording();
+	void recordPacket(const void * data, size_t size);
+
+	//Replay
+	//Stats are shared with the dispatched functions, which may run after the recorder is gone
+	struct ReplayStats
+	{
+		std::atomic<int> numDispatched { 0 };
+		std::atomic<int> numProcessed { 0 };
+
+		CriticalSection latencyLock;
+		Array<double> latencies; //in milliseconds, from the scheduled replay time to the end of processing, sampled once full
+		int64 numLatencies = 0;
+		double maxLatency = 0;
+		Random random;
+
+		void addLatency(double latency);
+	};
+
+	struct ReplayPacket
+	{
+		int64 dueTicks;
+		int64 order;
+		std::shared_ptr<OSCReceivedPacket> packet;
+	};
+
+	class DueTicksComparator
+	{
+	public:
+		int compareElements(const ReplayPacket &a, const ReplayPacket &b)
+		{
+			if (a.dueTicks != b.dueTicks) return a.dueTicks < b.dueTicks ? -1 : 1;
+			return a.order < b.order ? -1 : (a.order > b.order ? 1 : 0);
+		}
+	};
+
+	std::function<void(bool success, const String &report)> onReplayFinished; //called at the end of every replay, with the error if it failed
+
+	bool startReplay();
+	void stopReplay();
+	void dispatchReplayPacket(const ReplayPacket &p, std::shared_ptr<ReplayStats> stats);
+	static void processReplayedPacket(OSCModule * module, const OSCReceivedPacket &packet);
+	String getReplayReport(ReplayStats &stats, double elapsedSeconds, int numInvalid);
+	void finishReplay(bool success, const String &report);
+
+	void onContainerParameterChanged(Parameter * p) override;
+	void onContainerTriggerTriggered(Trigger * t) override;
+
+	void run() override;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OSCTrafficRecorder)
+};
@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+
+    OSCMulticast.cpp
+    Created: 17 Oct 2026 11:58:21pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "OSCMulticast.h"
+
+#if JUCE_WINDOWS
+#include <winsock2.h>
+#include <ws2tcpip.h>
+typedef DWORD SockOptValue; //winsock expects DWORDs for multicast options
+#else
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+typedef unsigned char SockOptValue;
+#endif
+
+namespace
+{
+	in_addr getInterfaceAddr(const String &interfaceAddress)
+	{
+		in_addr a;
+		a.s_addr = interfaceAddress.isEmpty() ? htonl(INADDR_ANY) : inet_addr(interfaceAddress.toRawUTF8());
+		return a;
+	}
+}
+
+bool OSCMulticast::isMulticastAddress(const String & address)
+{
+	IPAddress ip(address);
+	if (ip.isIPv6 || ip.toString() != address.trim()) return false;
+	return ip.address[0] >= 224 && ip.address[0] <= 239;
+}
+
+bool OSCMulticast::bindAndJoin(DatagramSocket & socket, int port, const String & group, const String & interfaceAddress)
+{
+	socket.setEnablePortReuse(true);
+	if (!socket.bindToPort(port)) return false;
+
+	ip_mreq mreq;
+	mreq.imr_multiaddr.s_addr = inet_addr(group.toRawUTF8());
+	mreq.imr_interface = getInterfaceAddr(interfaceAddress);
+
+	return setsockopt(socket.getRawSocketHandle(), IPPROTO_IP, IP_ADD_MEMBERSHIP, (const char *)&mreq, sizeof(mreq)) == 0;
+}
+
+bool OSCMulticast::setupSender(DatagramSocket & socket, const String & interfaceAddress, int ttl, bool loopback)
+{
+	auto handle = socket.getRawSocketHandle();
+	bool result = true;
+
+	if (interfaceAddress.isNotEmpty())
+	{
+		in_addr a = getInterfaceAddr(interfaceAddress);
+		result &= setsockopt(handle, IPPROTO_IP, IP_MULTICAST_IF, (const char *)&a, sizeof(a)) == 0;
+	}
+
+	SockOptValue ttlValue = (SockOptValue)jlimit<int>(1, 255, ttl);
+	result &= setsockopt(handle, IPPROTO_IP, IP_MULTICAST_TTL, (const char *)&ttlValue, sizeof(ttlValue)) == 0;
+
+	SockOptValue loopValue = loopback ? 1 : 0;
+	result &= setsockopt(handle, IPPROTO_IP, IP_MULTICAST_LOOP, (const char *)&loopValue, sizeof(loopValue)) == 0;
+
+	return result;
+}
+
+StringArray OSCMulticast::getInterfaceAddresses()
+{
+	Array<IPAddress> ad;
+	IPAddress::findAllAddresses(ad);
+
+	StringArray result;
+	for (auto &a : ad) if(!a.isIPv6) result.add(a.toString());
+	result.sort(false);
+	return result;
+}
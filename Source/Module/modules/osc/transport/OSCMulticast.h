@@ -0,0 +1,29 @@
+/*
+  ==============================================================================
+
+    OSCMulticast.h
+    Created: 17 Oct 2026 11:58:21pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "JuceHeader.h"
+
+/*
+	Multicast helpers working on a DatagramSocket's raw handle, as DatagramSocket can't choose the interface of a group nor the TTL.
+	Interfaces are given by their IPv4 address, an empty string lets the system choose.
+*/
+class OSCMulticast
+{
+public:
+	static bool isMulticastAddress(const String &address); //224.0.0.0 to 239.255.255.255
+
+	//binds the socket to the port with address reuse, so several receivers on the same machine can join the group
+	static bool bindAndJoin(DatagramSocket &socket, int port, const String &group, const String &interfaceAddress);
+	static bool setupSender(DatagramSocket &socket, const String &interfaceAddress, int ttl, bool loopback);
+
+	static StringArray getInterfaceAddresses();
+};
@@ -0,0 +1,404 @@
+/*
+  ==============================================================================
+
+    OSCPacketCodec.cpp
+    Created: 17 Oct 2026 10:31:54pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "OSCPacketCodec.h"
+
+namespace
+{
+	const uint8 slipEnd = 0xC0;
+	const uint8 slipEsc = 0xDB;
+	const uint8 slipEscEnd = 0xDC;
+	const uint8 slipEscEsc = 0xDD;
+
+	size_t getPaddedSize(size_t size) { return (size + 3) & ~(size_t)3; }
+}
+
+void OSCPacketCodec::writeMessage(OutputStream & os, const OSCMessage & m)
+{
+	writeString(os, m.getAddressPattern().toString());
+
+	String typeTags = ",";
+	for (auto &a : m) typeTags += a.getType();
+	writeString(os, typeTags);
+
+	for (auto &a : m) writeArgument(os, a);
+}
+
+void OSCPacketCodec::writeBundle(OutputStream & os, const OSCBundle & b)
+{
+	os.write("#bundle", 8); //includes the null terminator
+	os.writeInt64BigEndian((int64)b.getTimeTag().getRawTimeTag());
+
+	MemoryOutputStream element;
+	for (auto &e : b)
+	{
+		element.reset();
+		if (e.isMessage()) writeMessage(element, e.getMessage());
+		else writeBundle(element, e.getBundle());
+
+		os.writeIntBigEndian((int)element.getDataSize());
+		os.write(element.getData(), element.getDataSize());
+	}
+}
+
+OSCBundle::Element OSCPacketCodec::readPacket(const void * data, size_t size)
+{
+	const char * d = (const char *)data;
+	checkPacketSize(size);
+
+	if (isBundle(d, size)) return OSCBundle::Element(readBundle(d, size));
+	return OSCBundle::Element(readMessage(d, size));
+}
+
+std::shared_ptr<OSCReceivedPacket> OSCPacketCodec::decodePacket(const void * data, size_t size)
+{
+	const char * d = (const char *)data;
+	checkPacketSize(size);
+
+	std::shared_ptr<OSCReceivedPacket> packet(new OSCReceivedPacket());
+	if (!isBundle(d, size))
+	{
+		packet->messages.add(readReceivedMessage(d, size));
+		return packet;
+	}
+
+	packet->isBundle = true;
+	packet->timeTag = OSCTimeTag((uint64)ByteOrder::bigEndianInt64(d + 8));
+
+	size_t pos = 16;
+	while (pos < size)
+	{
+		if (pos + 4 > size) throw OSCFormatError("OSC bundle element is truncated");
+		int elementSize = (int)ByteOrder::bigEndianInt(d + pos);
+		pos += 4;
+		if (elementSize <= 0 || pos + (size_t)elementSize > size) throw OSCFormatError("OSC bundle element is truncated");
+
+		if (isBundle(d + pos, (size_t)elementSize)) packet->bundles.add(decodePacket(d + pos, (size_t)elementSize));
+		else
+		{
+			checkPacketSize((size_t)elementSize);
+			packet->messages.add(readReceivedMessage(d + pos, (size_t)elementSize));
+		}
+
+		pos += (size_t)elementSize;
+	}
+
+	return packet;
+}
+
+void OSCPacketCodec::checkPacketSize(size_t size)
+{
+	if (size == 0 || size % 4 != 0) throw OSCFormatError("OSC packet size must be a non-zero multiple of 4");
+}
+
+bool OSCPacketCodec::isBundle(const char * data, size_t size)
+{
+	return size >= 16 && memcmp(data, "#bundle", 8) == 0;
+}
+
+void OSCPacketCodec::writeString(OutputStream & os, const String & s)
+{
+	size_t numBytes = s.getNumBytesAsUTF8();
+	os.write(s.toRawUTF8(), numBytes);
+	os.writeRepeatedByte(0, getPaddedSize(numBytes + 1) - numBytes);
+}
+
+void OSCPacketCodec::writeArgument(OutputStream & os, const OSCArgument & a)
+{
+	if (a.isInt32()) os.writeIntBigEndian(a.getInt32());
+	else if (a.isFloat32()) os.writeFloatBigEndian(a.getFloat32());
+	else if (a.isString()) writeString(os, a.getString());
+	else if (a.isColour())
+	{
+		OSCColour c = a.getColour();
+		os.writeByte((char)c.red);
+		os.writeByte((char)c.green);
+		os.writeByte((char)c.blue);
+		os.writeByte((char)c.alpha);
+	}
+	else if (a.isBlob())
+	{
+		const MemoryBlock &b = a.getBlob();
+		os.writeIntBigEndian((int)b.getSize());
+		os.write(b.getData(), b.getSize());
+		os.writeRepeatedByte(0, getPaddedSize(b.getSize()) - b.getSize());
+	}
+}
+
+OSCMessage OSCPacketCodec::readMessage(const char * data, size_t size, Array<var> * values)
+{
+	size_t pos = 0;
+	OSCMessage m(OSCAddressPattern(readString(data, size, pos)));
+
+	if (pos >= size) return m; //no type tags, accepted for older implementations
+	String typeTags = readString(data, size, pos);
+	if (!typeTags.startsWithChar(',')) throw OSCFormatError("OSC type tag string must start with a comma");
+
+	auto readInt = [&]()
+	{
+		if (pos + 4 > size) throw OSCFormatError("OSC argument is truncated");
+		int v = (int)ByteOrder::bigEndianInt(data + pos);
+		pos += 4;
+		return v;
+	};
+
+	auto readInt64 = [&]()
+	{
+		if (pos + 8 > size) throw OSCFormatError("OSC argument is truncated");
+		uint64 v = ByteOrder::bigEndianInt64(data + pos);
+		pos += 8;
+		return v;
+	};
+
+	//the message gets the argument as OSCArgument can hold it, the values get it exact
+	auto add = [&](const OSCArgument &a, const var &value)
+	{
+		m.addArgument(a);
+		if (values != nullptr) values->add(value);
+	};
+
+	for (int i = 1; i < typeTags.length(); i++)
+	{
+		switch (typeTags[i])
+		{
+		case 'i':
+		case 'c': //ascii character
+		case 'm': //midi message
+		{
+			int v = readInt();
+			add(OSCArgument(v), v);
+		}
+		break;
+
+		case 'f':
+		{
+			int v = readInt();
+			float f;
+			memcpy(&f, &v, 4);
+			add(OSCArgument(f), f);
+		}
+		break;
+
+		case 's':
+		case 'S': //symbol
+		{
+			String v = readString(data, size, pos);
+			add(OSCArgument(v), v);
+		}
+		break;
+
+		case 'r':
+		{
+			if (pos + 4 > size) throw OSCFormatError("OSC argument is truncated");
+			OSCColour c = { (uint8)data[pos], (uint8)data[pos + 1], (uint8)data[pos + 2], (uint8)data[pos + 3] };
+			add(OSCArgument(c), (int)c.toInt32());
+			pos += 4;
+		}
+		break;
+
+		case 'b':
+		{
+			int blobSize = readInt();
+			if (blobSize < 0 || pos + (size_t)blobSize > size) throw OSCFormatError("OSC blob is truncated");
+
+			//the blob is copied once out of the packet, into the var that the message values and the scripts then share.
+			//The message only keeps an empty blob to keep its argument indices and types
+			if (values != nullptr)
+			{
+				values->add(var(data + pos, (size_t)blobSize));
+				m.addBlob(MemoryBlock());
+			}
+			else m.addBlob(MemoryBlock(data + pos, (size_t)blobSize));
+
+			pos += getPaddedSize((size_t)blobSize);
+		}
+		break;
+
+		case 'h':
+		{
+			int64 v = (int64)readInt64();
+			add(v >= INT32_MIN && v <= INT32_MAX ? OSCArgument((int)v) : OSCArgument((float)v), v);
+		}
+		break;
+
+		case 'd':
+		{
+			uint64 bits = readInt64();
+			double d;
+			memcpy(&d, &bits, 8);
+			add(OSCArgument((float)d), d);
+		}
+		break;
+
+		case 't': //time tag, given as seconds since 1970
+		{
+			uint64 raw = readInt64();
+			double seconds = (double)(raw >> 32) - 2208988800.0 + (double)(raw & 0xFFFFFFFF) / 4294967296.0;
+			add(OSCArgument((float)seconds), seconds);
+		}
+		break;
+
+		case 'T': add(OSCArgument(1), true); break;
+		case 'F': add(OSCArgument(0), false); break;
+		case 'N': case 'I': break; //no data, not representable
+
+		default:
+			throw OSCFormatError("OSC type tag not supported : " + String::charToString(typeTags[i]));
+		}
+	}
+
+	return m;
+}
+
+OSCReceivedMessage OSCPacketCodec::readReceivedMessage(const char * data, size_t size)
+{
+	Array<var> values;
+	OSCReceivedMessage m(readMessage(data, size, &values));
+	m.values.swapWith(values);
+	return m;
+}
+
+OSCBundle OSCPacketCodec::readBundle(const char * data, size_t size)
+{
+	OSCBundle b(OSCTimeTag((uint64)ByteOrder::bigEndianInt64(data + 8)));
+
+	size_t pos = 16;
+	while (pos < size)
+	{
+		if (pos + 4 > size) throw OSCFormatError("OSC bundle element is truncated");
+		int elementSize = (int)ByteOrder::bigEndianInt(data + pos);
+		pos += 4;
+		if (elementSize <= 0 || pos + (size_t)elementSize > size) throw OSCFormatError("OSC bundle element is truncated");
+
+		b.addElement(readPacket(data + pos, (size_t)elementSize));
+		pos += (size_t)elementSize;
+	}
+
+	return b;
+}
+
+String OSCPacketCodec::readString(const char * data, size_t size, size_t & pos)
+{
+	size_t end = pos;
+	while (end < size && data[end] != 0) end++;
+	if (end >= size) throw OSCFormatError("OSC string is not terminated");
+
+	String s = String::fromUTF8(data + pos, (int)(end - pos));
+	pos += getPaddedSize(end - pos + 1);
+	return s;
+}
+
+
+//FRAMER
+
+OSCStreamFramer::OSCStreamFramer(Framing framing) :
+	framing(framing),
+	escapeNext(false)
+{
+}
+
+OSCStreamFramer::~OSCStreamFramer()
+{
+}
+
+void OSCStreamFramer::process(const uint8 * data, int size, std::function<void(const void *, size_t)> onPacket)
+{
+	if (framing == SLIP)
+	{
+		for (int i = 0; i < size; i++)
+		{
+			uint8 b = data[i];
+			if (escapeNext)
+			{
+				escapeNext = false;
+				if (b == slipEscEnd) b = slipEnd;
+				else if (b == slipEscEsc) b = slipEsc;
+			}
+			else if (b == slipEsc)
+			{
+				escapeNext = true;
+				continue;
+			}
+			else if (b == slipEnd)
+			{
+				if (pending.getDataSize() > 0) onPacket(pending.getData(), pending.getDataSize());
+				pending.reset();
+				continue;
+			}
+
+			if ((int)pending.getDataSize() >= maxPacketSize) pending.reset(); //garbage, drop until the next END
+			pending.writeByte((char)b);
+		}
+
+		return;
+	}
+
+	pending.write(data, (size_t)size);
+
+	const char * d = (const char *)pending.getData();
+	size_t available = pending.getDataSize();
+	size_t pos = 0;
+
+	while (available - pos >= 4)
+	{
+		int packetSize = (int)ByteOrder::bigEndianInt(d + pos);
+		if (packetSize < 0 || packetSize > maxPacketSize)
+		{
+			//stream is out of sync, nothing can be trusted anymore
+			pending.reset();
+			return;
+		}
+
+		if (available - pos - 4 < (size_t)packetSize) break;
+		onPacket(d + pos + 4, (size_t)packetSize);
+		pos += 4 + (size_t)packetSize;
+	}
+
+	if (pos > 0)
+	{
+		MemoryBlock remaining(d + pos, available - pos);
+		pending.reset();
+		pending.write(remaining.getData(), remaining.getSize());
+	}
+}
+
+void OSCStreamFramer::reset()
+{
+	pending.reset();
+	escapeNext = false;
+}
+
+void OSCStreamFramer::writeFrame(Framing framing, OutputStream & os, const void * packet, size_t size)
+{
+	if (framing == LENGTH_PREFIX)
+	{
+		os.writeIntBigEndian((int)size);
+		os.write(packet, size);
+		return;
+	}
+
+	const uint8 * p = (const uint8 *)packet;
+	os.writeByte((char)slipEnd);
+	for (size_t i = 0; i < size; i++)
+	{
+		if (p[i] == slipEnd)
+		{
+			os.writeByte((char)slipEsc);
+			os.writeByte((char)slipEscEnd);
+		}
+		else if (p[i] == slipEsc)
+		{
+			os.writeByte((char)slipEsc);
+			os.writeByte((char)slipEscEsc);
+		}
+		else os.writeByte((char)p[i]);
+	}
+	os.writeByte((char)slipEnd);
+}
@@ -0,0 +1,90 @@
+/*
+  ==============================================================================
+
+    OSCPacketCodec.h
+    Created: 17 Oct 2026 10:31:54pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "JuceHeader.h"
+
+/*
+	A received OSC message, with the value of each of its arguments.
+	OSCArgument has no int64 or double type : the message holds those narrowed to int32 or float32, the values keep them as int64 and double vars.
+	Blobs are binary vars, shared by every copy of the values. The message only holds empty blobs in their place.
+*/
+struct OSCReceivedMessage
+{
+	OSCReceivedMessage(const OSCMessage &message) : message(message) {}
+
+	OSCMessage message;
+	Array<var> values;
+};
+
+/*
+	A received packet : a single message, or a bundle with its time tag, its messages and its nested bundles.
+*/
+struct OSCReceivedPacket
+{
+	bool isBundle = false;
+	OSCTimeTag timeTag;
+	Array<OSCReceivedMessage> messages;
+	Array<std::shared_ptr<OSCReceivedPacket>> bundles;
+};
+
+/*
+	OSC packet encoding and decoding, used for all received packets and for the transports that juce::OSCSender doesn't handle (TCP streams).
+*/
+class OSCPacketCodec
+{
+public:
+	static void writeMessage(OutputStream &os, const OSCMessage &m);
+	static void writeBundle(OutputStream &os, const OSCBundle &b);
+
+	//both throw OSCFormatError if the packet is not valid
+	static OSCBundle::Element readPacket(const void * data, size_t size);
+	static std::shared_ptr<OSCReceivedPacket> decodePacket(const void * data, size_t size);
+
+private:
+	static void writeString(OutputStream &os, const String &s);
+	static void writeArgument(OutputStream &os, const OSCArgument &a);
+
+	static void checkPacketSize(size_t size);
+	static bool isBundle(const char * data, size_t size);
+	static OSCMessage readMessage(const char * data, size_t size, Array<var> * values = nullptr);
+	static OSCReceivedMessage readReceivedMessage(const char * data, size_t size);
+	static OSCBundle readBundle(const char * data, size_t size);
+	static String readString(const char * data, size_t size, size_t &pos);
+};
+
+/*
+	Packet framing over a byte stream, as defined by OSC 1.1 (SLIP, RFC 1055) and OSC 1.0 (int32 size prefix).
+	process() can be fed with any chunk of data, and calls onPacket for each complete packet.
+*/
+class OSCStreamFramer
+{
+public:
+	enum Framing { SLIP, LENGTH_PREFIX };
+
+	OSCStreamFramer(Framing framing);
+	~OSCStreamFramer();
+
+	static const int maxPacketSize = 16 * 1024 * 1024;
+
+	Framing framing;
+
+	void process(const uint8 * data, int size, std::function<void(const void *, size_t)> onPacket);
+	void reset();
+
+	static void writeFrame(Framing framing, OutputStream &os, const void * packet, size_t size);
+
+private:
+	MemoryOutputStream pending;
+	bool escapeNext;
+
+	JUCE_DECLARE_NON_COPYABLE(OSCStreamFramer)
+};
@@ -0,0 +1,152 @@
+/*
+  ==============================================================================
+
+    OSCSendWorker.cpp
+    Created: 17 Oct 2026 11:40:09pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "OSCSendWorker.h"
+
+OSCSendWorker::OSCSendWorker(const String & name, SendMessageFunction sendMessageFunc, SendBundleFunction sendBundleFunc, int capacity) :
+	Thread("OSC Send " + name),
+	dropPolicy(DROP_OLDEST),
+	numDropped(0),
+	sendMessageFunc(sendMessageFunc),
+	sendBundleFunc(sendBundleFunc),
+	queue(capacity),
+	lastStatsTime(0),
+	lastReportedDepth(0),
+	lastReportedDropped(0)
+{
+}
+
+OSCSendWorker::~OSCSendWorker()
+{
+	signalThreadShouldExit();
+	notify();
+	stopThread(1000);
+}
+
+bool OSCSendWorker::send(const OSCMessage & m)
+{
+	if (dropPolicy == COALESCE)
+	{
+		{
+			const ScopedLock lock(coalesceLock);
+			const String address = m.getAddressPattern().toString();
+			if (coalescedIndex.contains(address))
+			{
+				coalescedMessages.set(coalescedIndex[address], m);
+				numDropped++;
+			}
+			else
+			{
+				if (coalescedMessages.size() >= queue.getCapacity())
+				{
+					numDropped++;
+					return false;
+				}
+
+				coalescedIndex.set(address, coalescedMessages.size());
+				coalescedMessages.add(m);
+			}
+		}
+
+		notify();
+		return true;
+	}
+
+	Packet p;
+	p.message.reset(new OSCMessage(m));
+	return push(std::move(p));
+}
+
+bool OSCSendWorker::send(const OSCBundle & b)
+{
+	Packet p;
+	p.bundle.reset(new OSCBundle(b));
+	return push(std::move(p));
+}
+
+int OSCSendWorker::getQueueDepth()
+{
+	const ScopedLock lock(coalesceLock);
+	return queue.getNumReady() + coalescedMessages.size();
+}
+
+void OSCSendWorker::clear()
+{
+	Packet p;
+	while (queue.pop(p)) {}
+
+	const ScopedLock lock(coalesceLock);
+	coalescedMessages.clear();
+	coalescedIndex.clear();
+}
+
+bool OSCSendWorker::push(Packet && p)
+{
+	if (dropPolicy == DROP_OLDEST && queue.getNumReady() >= queue.getCapacity())
+	{
+		Packet oldest;
+		if (queue.pop(oldest)) numDropped++;
+	}
+
+	if (!queue.push(std::move(p)))
+	{
+		numDropped++;
+		return false;
+	}
+
+	notify();
+	return true;
+}
+
+void OSCSendWorker::reportStats()
+{
+	uint32 t = Time::getMillisecondCounter();
+	if (t - lastStatsTime < 100) return;
+	lastStatsTime = t;
+
+	int depth = getQueueDepth();
+	int dropped = numDropped.load();
+	if (depth == lastReportedDepth && dropped == lastReportedDropped) return;
+
+	lastReportedDepth = depth;
+	lastReportedDropped = dropped;
+	if (onStatsChanged != nullptr) onStatsChanged(depth, dropped);
+}
+
+void OSCSendWorker::run()
+{
+	Packet p;
+
+	while (!threadShouldExit())
+	{
+		while (!threadShouldExit() && queue.pop(p))
+		{
+			if (p.message != nullptr) sendMessageFunc(*p.message);
+			else if (p.bundle != nullptr) sendBundleFunc(*p.bundle);
+			reportStats();
+		}
+
+		{
+			const ScopedLock lock(coalesceLock);
+			messagesToSend.swapWith(coalescedMessages);
+			coalescedIndex.clear();
+		}
+
+		for (auto &m : messagesToSend)
+		{
+			if (threadShouldExit()) break;
+			sendMessageFunc(m);
+		}
+		messagesToSend.clearQuick();
+
+		reportStats();
+		wait(100);
+	}
+}
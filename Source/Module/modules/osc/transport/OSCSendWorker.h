@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+    OSCSendWorker.h
+    Created: 17 Oct 2026 11:40:09pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "JuceHeader.h"
+#include "Common/Engine/LockFreeQueue.h"
+
+/*
+	Bounded send queue drained by a dedicated thread, so that a slow or unreachable target never blocks the sending thread
+	nor delays other outputs. When the queue is full, the drop policy decides what is lost :
+	- Drop Oldest discards the oldest queued packet to make room for the new one
+	- Drop Newest discards the new packet
+	- Coalesce keeps only the latest queued message for each address, so nothing is dropped until there are more pending addresses than the capacity
+*/
+class OSCSendWorker :
+	public Thread
+{
+public:
+	enum DropPolicy { DROP_OLDEST, DROP_NEWEST, COALESCE };
+
+	typedef std::function<void(const OSCMessage &)> SendMessageFunction;
+	typedef std::function<void(const OSCBundle &)> SendBundleFunction;
+	typedef std::function<void(int queueDepth, int numDropped)> StatsFunction;
+
+	OSCSendWorker(const String &name, SendMessageFunction sendMessageFunc, SendBundleFunction sendBundleFunc, int capacity = 4096);
+	~OSCSendWorker();
+
+	std::atomic<int> dropPolicy;
+	std::atomic<int> numDropped;
+	StatsFunction onStatsChanged; //called from the worker thread, at most every 100ms
+
+	bool send(const OSCMessage &m);
+	bool send(const OSCBundle &b);
+	int getQueueDepth();
+	void clear();
+
+	void run() override;
+
+private:
+	struct Packet
+	{
+		std::unique_ptr<OSCMessage> message;
+		std::unique_ptr<OSCBundle> bundle;
+	};
+
+	SendMessageFunction sendMessageFunc;
+	SendBundleFunction sendBundleFunc;
+
+	LockFreeQueue<Packet> queue;
+
+	CriticalSection coalesceLock;
+	Array<OSCMessage> coalescedMessages;
+	HashMap<String, int> coalescedIndex;
+	Array<OSCMessage> messagesToSend;
+
+	bool push(Packet &&p);
+	void reportStats();
+
+	uint32 lastStatsTime;
+	int lastReportedDepth;
+	int lastReportedDropped;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OSCSendWorker)
+};
@@ -0,0 +1,249 @@
+/*
+  ==============================================================================
+
+    OSCTCPTransport.cpp
+    Created: 17 Oct 2026 10:58:16pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "OSCTCPTransport.h"
+
+OSCTCPServer::OSCTCPServer(Listener * listener) :
+	Thread("OSC TCP Server"),
+	listener(listener),
+	framing(OSCStreamFramer::SLIP)
+{
+}
+
+OSCTCPServer::~OSCTCPServer()
+{
+	stop();
+}
+
+bool OSCTCPServer::start(int port, OSCStreamFramer::Framing _framing)
+{
+	stop();
+
+	framing = _framing;
+	if (!serverSocket.createListener(port)) return false;
+
+	startThread();
+	return true;
+}
+
+void OSCTCPServer::stop()
+{
+	signalThreadShouldExit();
+	serverSocket.close(); //unblocks waitForNextConnection
+	stopThread(1000);
+
+	clients.clear();
+	if (listener != nullptr) listener->tcpClientsChanged(0);
+}
+
+int OSCTCPServer::getNumClients()
+{
+	const ScopedLock lock(clients.getLock());
+	int result = 0;
+	for (auto &c : clients) if (!c->isFinished) result++;
+	return result;
+}
+
+void OSCTCPServer::run()
+{
+	while (!threadShouldExit())
+	{
+		removeFinishedClients();
+
+		//poll rather than block in accept, so disconnected clients are removed and reported without waiting for the next connection
+		int ready = serverSocket.waitUntilReady(true, 100);
+		if (ready < 0) break;
+		if (ready == 0) continue;
+
+		StreamingSocket * s = serverSocket.waitForNextConnection();
+		if (s == nullptr)
+		{
+			if (!serverSocket.isConnected()) break;
+			continue;
+		}
+
+		if (threadShouldExit())
+		{
+			delete s;
+			break;
+		}
+
+		Client * c = new Client(this, s);
+		clients.add(c);
+		c->startThread();
+
+		if (listener != nullptr) listener->tcpClientsChanged(getNumClients());
+	}
+}
+
+void OSCTCPServer::removeFinishedClients()
+{
+	bool changed = false;
+	{
+		const ScopedLock lock(clients.getLock());
+		for (int i = clients.size() - 1; i >= 0; i--)
+		{
+			if (clients[i]->isFinished)
+			{
+				clients.remove(i);
+				changed = true;
+			}
+		}
+	}
+
+	if (changed && listener != nullptr) listener->tcpClientsChanged(getNumClients());
+}
+
+OSCTCPServer::Client::Client(OSCTCPServer * server, StreamingSocket * socket) :
+	Thread("OSC TCP Client " + socket->getHostName()),
+	server(server),
+	socket(socket),
+	framer(server->framing),
+	isFinished(false)
+{
+}
+
+OSCTCPServer::Client::~Client()
+{
+	signalThreadShouldExit();
+	socket->close();
+	stopThread(1000);
+}
+
+void OSCTCPServer::Client::run()
+{
+	uint8 buffer[8192];
+	while (!threadShouldExit())
+	{
+		int ready = socket->waitUntilReady(true, 100);
+		if (ready < 0) break;
+		if (ready == 0) continue;
+
+		int numRead = socket->read(buffer, sizeof(buffer), false);
+		if (numRead <= 0) break; //closed by the client
+
+		framer.process(buffer, numRead, [this](const void * data, size_t size) { server->listener->tcpPacketReceived(data, size); });
+	}
+
+	isFinished = true;
+}
+
+
+//SENDER
+
+OSCTCPSender::OSCTCPSender(const String &name) :
+	Thread("OSC TCP Sender " + name),
+	framing(OSCStreamFramer::SLIP),
+	port(0),
+	queue(4096),
+	isConnected(false),
+	numDropped(0),
+	hasLoggedError(false)
+{
+}
+
+OSCTCPSender::~OSCTCPSender()
+{
+	disconnect();
+}
+
+void OSCTCPSender::connect(const String & _host, int _port, OSCStreamFramer::Framing _framing)
+{
+	disconnect();
+
+	host = _host;
+	port = _port;
+	framing = _framing;
+	hasLoggedError = false;
+
+	startThread();
+}
+
+void OSCTCPSender::disconnect()
+{
+	signalThreadShouldExit();
+	notify();
+	stopThread(2000);
+
+	socket.close();
+	isConnected = false;
+
+	MemoryBlock b;
+	while (queue.pop(b)) {}
+}
+
+bool OSCTCPSender::send(const OSCMessage & m)
+{
+	MemoryOutputStream packet;
+	OSCPacketCodec::writeMessage(packet, m);
+	return sendPacket(packet);
+}
+
+bool OSCTCPSender::send(const OSCBundle & b)
+{
+	MemoryOutputStream packet;
+	OSCPacketCodec::writeBundle(packet, b);
+	return sendPacket(packet);
+}
+
+bool OSCTCPSender::sendPacket(const MemoryOutputStream & packet)
+{
+	if (!isThreadRunning()) return false;
+
+	MemoryOutputStream frame(packet.getDataSize() + 8);
+	OSCStreamFramer::writeFrame(framing, frame, packet.getData(), packet.getDataSize());
+
+	if (!queue.push(frame.getMemoryBlock()))
+	{
+		numDropped++;
+		return false;
+	}
+
+	notify();
+	return true;
+}
+
+void OSCTCPSender::run()
+{
+	MemoryBlock b;
+
+	while (!threadShouldExit())
+	{
+		if (!socket.isConnected())
+		{
+			isConnected = false;
+			if (!socket.connect(host, port, 1000))
+			{
+				if (!hasLoggedError) LOGWARNING("Could not connect to OSC TCP server " << host << ":" << port << ", retrying..");
+				hasLoggedError = true;
+
+				while (queue.pop(b)) {} //no point in sending old data once the connection is back
+				wait(1000);
+				continue;
+			}
+
+			LOG("Connected to OSC TCP server " << host << ":" << port);
+			hasLoggedError = false;
+			isConnected = true;
+		}
+
+		while (!threadShouldExit() && queue.pop(b))
+		{
+			if (socket.write(b.getData(), (int)b.getSize()) < 0)
+			{
+				LOGWARNING("Connection to OSC TCP server " << host << ":" << port << " lost");
+				socket.close();
+				break;
+			}
+		}
+
+		wait(50);
+	}
+}
@@ -0,0 +1,100 @@
+/*
+  ==============================================================================
+
+    OSCTCPTransport.h
+    Created: 17 Oct 2026 10:58:16pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "OSCPacketCodec.h"
+#include "Common/Engine/LockFreeQueue.h"
+
+/*
+	Receives framed OSC packets from any number of TCP clients, each client is read by its own thread.
+*/
+class OSCTCPServer :
+	public Thread
+{
+public:
+	class Listener
+	{
+	public:
+		virtual ~Listener() {}
+		virtual void tcpPacketReceived(const void * data, size_t size) = 0;
+		virtual void tcpClientsChanged(int /*numClients*/) {}
+	};
+
+	OSCTCPServer(Listener * listener);
+	~OSCTCPServer();
+
+	Listener * listener;
+	OSCStreamFramer::Framing framing;
+
+	bool start(int port, OSCStreamFramer::Framing framing);
+	void stop();
+	int getNumClients();
+
+	void run() override;
+
+private:
+	class Client :
+		public Thread
+	{
+	public:
+		Client(OSCTCPServer * server, StreamingSocket * socket);
+		~Client();
+
+		OSCTCPServer * server;
+		std::unique_ptr<StreamingSocket> socket;
+		OSCStreamFramer framer;
+		std::atomic<bool> isFinished;
+
+		void run() override;
+	};
+
+	StreamingSocket serverSocket;
+	OwnedArray<Client, CriticalSection> clients;
+
+	void removeFinishedClients();
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OSCTCPServer)
+};
+
+/*
+	Sends framed OSC packets to a TCP server. Packets are encoded on the calling thread and written by a dedicated thread,
+	so sending never blocks. The connection is retried automatically while the sender is active.
+*/
+class OSCTCPSender :
+	public Thread
+{
+public:
+	OSCTCPSender(const String &name);
+	~OSCTCPSender();
+
+	OSCStreamFramer::Framing framing;
+	String host;
+	int port;
+
+	LockFreeQueue<MemoryBlock> queue;
+	std::atomic<bool> isConnected;
+	std::atomic<int> numDropped;
+
+	void connect(const String &host, int port, OSCStreamFramer::Framing framing);
+	void disconnect();
+
+	bool send(const OSCMessage &m);
+	bool send(const OSCBundle &b);
+	bool sendPacket(const MemoryOutputStream &packet);
+
+	void run() override;
+
+private:
+	StreamingSocket socket;
+	bool hasLoggedError;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OSCTCPSender)
+};
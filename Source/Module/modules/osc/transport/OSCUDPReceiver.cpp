@@ -0,0 +1,75 @@
+/*
+  ==============================================================================
+
+    OSCUDPReceiver.cpp
+    Created: 18 Oct 2026 9:42:10am
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "OSCUDPReceiver.h"
+
+OSCUDPReceiver::OSCUDPReceiver(Listener * listener) :
+	Thread("OSC UDP Receiver"),
+	listener(listener),
+	socket(nullptr),
+	buffer(maxPacketSize)
+{
+}
+
+OSCUDPReceiver::~OSCUDPReceiver()
+{
+	disconnect();
+}
+
+bool OSCUDPReceiver::connect(int port)
+{
+	disconnect();
+
+	ownedSocket.reset(new DatagramSocket(false));
+	if (!ownedSocket->bindToPort(port))
+	{
+		ownedSocket.reset();
+		return false;
+	}
+
+	socket = ownedSocket.get();
+	startThread();
+	return true;
+}
+
+bool OSCUDPReceiver::connectToSocket(DatagramSocket & s)
+{
+	disconnect();
+
+	if (s.getBoundPort() < 0) return false;
+
+	socket = &s;
+	startThread();
+	return true;
+}
+
+void OSCUDPReceiver::disconnect()
+{
+	signalThreadShouldExit();
+	if (ownedSocket != nullptr) ownedSocket->shutdown(); //unblocks the read
+	stopThread(1000);
+
+	ownedSocket.reset();
+	socket = nullptr;
+}
+
+void OSCUDPReceiver::run()
+{
+	while (!threadShouldExit())
+	{
+		int ready = socket->waitUntilReady(true, 100);
+		if (ready < 0) break;
+		if (ready == 0) continue;
+
+		int numRead = socket->read(buffer, maxPacketSize, false);
+		if (numRead < 0) break;
+		if (numRead > 0 && !threadShouldExit()) listener->udpPacketReceived(buffer, (size_t)numRead);
+	}
+}
@@ -0,0 +1,49 @@
+/*
+  ==============================================================================
+
+    OSCUDPReceiver.h
+    Created: 18 Oct 2026 9:42:10am
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "OSCPacketCodec.h"
+
+/*
+	Receives OSC packets over UDP and hands them raw to the listener, which decodes them with OSCPacketCodec.
+	Unlike juce::OSCReceiver, this keeps int64 and double arguments instead of rejecting the whole packet.
+*/
+class OSCUDPReceiver :
+	public Thread
+{
+public:
+	class Listener
+	{
+	public:
+		virtual ~Listener() {}
+		virtual void udpPacketReceived(const void * data, size_t size) = 0;
+	};
+
+	OSCUDPReceiver(Listener * listener);
+	~OSCUDPReceiver();
+
+	static const int maxPacketSize = 65536;
+
+	Listener * listener;
+
+	bool connect(int port);
+	bool connectToSocket(DatagramSocket &socket); //the socket is not owned, it must outlive the connection
+	void disconnect();
+
+	void run() override;
+
+private:
+	std::unique_ptr<DatagramSocket> ownedSocket;
+	DatagramSocket * socket;
+	HeapBlock<char> buffer;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OSCUDPReceiver)
+};
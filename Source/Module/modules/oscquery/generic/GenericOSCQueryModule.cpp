@@ -11,18 +11,37 @@
 #include "GenericOSCQueryModule.h"
 #include "ui/OSCQueryModuleEditor.h"
 #include "GenericOSCQueryCommand.h"
+#include "Module/modules/osc/transport/OSCPacketCodec.h"
+
+namespace
+{
+	String getCommandString(const String &command, const String &data)
+	{
+		DynamicObject * o = new DynamicObject();
+		o->setProperty("COMMAND", command);
+		o->setProperty("DATA", data);
+		return JSON::toString(var(o), true);
+	}
+}
 
 GenericOSCQueryModule::GenericOSCQueryModule(const String & name, int defaultRemotePort) :
 	Module(name),
 	Thread("OSCQuery"),
     useLocal(nullptr),
     remoteHost(nullptr),
-    remotePort(nullptr)
+    remotePort(nullptr),
+	isUpdatingTree(false),
+	valuesUpdatePending(false),
+	syncPending(false)
 {
 	alwaysShowValues = true;
 	setupIOConfiguration(false, true);
 
 	syncTrigger = moduleParams.addTrigger("Sync Data", "Sync the data");
+	listenAll = moduleParams.addBoolParameter("Listen All", "If checked, ask the remote host to send back the changes of all values. Otherwise, only the values given to the script function listen() are updated.\nChanges of the namespace are always received when the remote host supports it.", true);
+	isListening = moduleParams.addBoolParameter("Listening", "Is the WebSocket connection to the remote host open", false);
+	isListening->setControllableFeedbackOnly(true);
+	isListening->isSavable = false;
 
 	sendCC.reset(new OSCQueryOutput(this));
 	moduleParams.addChildControllableContainer(sendCC.get());
@@ -37,12 +56,22 @@ GenericOSCQueryModule::GenericOSCQueryModule(const String & name, int defaultRem
 
 	sender.connect("0.0.0.0", 0);
 
+	wsClient.reset(new WebSocketClient(niceName));
+	wsClient->addWebSocketListener(this);
+
+	scriptObject.setMethod(listenId, GenericOSCQueryModule::listenFromScript);
+	scriptObject.setMethod(ignoreId, GenericOSCQueryModule::ignoreFromScript);
+
 	syncTrigger->trigger();
 }
 
 GenericOSCQueryModule::~GenericOSCQueryModule()
 {
+	wsClient->removeWebSocketListener(this);
+	wsClient.reset();
+
 	signalThreadShouldExit();
+	notify();
 	waitForThreadToExit(2000);
 }
 
@@ -81,13 +110,15 @@ void GenericOSCQueryModule::sendOSCForControllable(Controllable * c)
 
 void GenericOSCQueryModule::syncData()
 {
+	syncPending = true;
 	startThread();
+	notify();
 }
 
 void GenericOSCQueryModule::createTreeFromData(var data)
 {
-	valuesCC.clear();
-	fillContainerFromData(&valuesCC, data);
+	ScopedValueSetter<bool> updating(isUpdatingTree, true);
+	updateContainerFromData(&valuesCC, data);
 }
 
 void GenericOSCQueryModule::fillContainerFromData(ControllableContainer * cc, var data)
@@ -96,29 +127,108 @@ void GenericOSCQueryModule::fillContainerFromData(ControllableContainer * cc, va
 	if (dataObject != nullptr)
 	{
 		NamedValueSet nvSet = dataObject->getProperties(); 
-		for (auto & nv : nvSet)
+		for (auto & nv : nvSet) addNodeFromData(cc, nv.name.toString(), nv.value);
+	}
+}
+
+void GenericOSCQueryModule::addNodeFromData(ControllableContainer * cc, const String & name, var data)
+{
+	int access = data.getProperty("ACCESS", -1);
+	if (access == 0) //group
+	{
+		String ccNiceName = data.getProperty("DESCRIPTION", "");
+		if (ccNiceName.isEmpty()) ccNiceName = name;
+
+		ControllableContainer * childCC = new ControllableContainer(ccNiceName);
+		childCC->setCustomShortName(name);
+		fillContainerFromData(childCC, data);
+		valuesContainers.add(childCC);
+		childCC->editorIsCollapsed = true;
+
+		cc->addChildControllableContainer(childCC);
+	}
+	else if (access > 0) //parameter
+	{
+		Controllable * c = createControllableFromData(name, data);
+		if (c != nullptr) cc->addControllable(c);
+	}
+}
+
+void GenericOSCQueryModule::updateContainerFromData(ControllableContainer * cc, var data)
+{
+	NamedValueSet nvSet;
+	if (DynamicObject * dataObject = data.getProperty("CONTENTS", var()).getDynamicObject()) nvSet = dataObject->getProperties();
+
+	Array<Controllable *> removedControllables;
+	for (auto &c : cc->controllables) if (!nvSet.contains(c->shortName)) removedControllables.add(c);
+	for (auto &c : removedControllables) cc->removeControllable(c);
+
+	Array<ControllableContainer *> removedContainers;
+	for (auto &childCC : cc->controllableContainers) if (!childCC.wasObjectDeleted() && !nvSet.contains(childCC->shortName)) removedContainers.add(childCC);
+	for (auto &childCC : removedContainers) removeContainer(childCC);
+
+	for (auto &nv : nvSet) updateNodeFromData(cc, nv.name.toString(), nv.value);
+}
+
+void GenericOSCQueryModule::updateNodeFromData(ControllableContainer * cc, const String & name, var data)
+{
+	int access = data.getProperty("ACCESS", -1);
+	Controllable * existing = cc->getControllableByName(name);
+	ControllableContainer * existingCC = cc->getControllableContainerByName(name);
+
+	if (access == 0) //group
+	{
+		if (existing != nullptr) cc->removeControllable(existing);
+		if (existingCC == nullptr)
 		{
-			int access = nv.value.getProperty("ACCESS", -1);
-			if (access == 0) //group
-			{
-				String ccNiceName = nv.value.getProperty("DESCRIPTION", "");
-				if (ccNiceName.isEmpty()) ccNiceName = nv.name.toString();
-				
-				ControllableContainer * childCC = new ControllableContainer(ccNiceName);
-				childCC->setCustomShortName(nv.name.toString());
-				fillContainerFromData(childCC, nv.value);
-				valuesContainers.add(childCC);
-				childCC->editorIsCollapsed = true;
-
-				cc->addChildControllableContainer(childCC);
-			}
-			else if (access > 0) //parameter
-			{
-				Controllable * c = createControllableFromData(nv.name, nv.value);
-				if(c != nullptr) cc->addControllable(c);
-			}
+			addNodeFromData(cc, name, data);
+			return;
 		}
+
+		String ccNiceName = data.getProperty("DESCRIPTION", "");
+		existingCC->setNiceName(ccNiceName.isNotEmpty() ? ccNiceName : name);
+		updateContainerFromData(existingCC, data);
 	}
+	else if (access > 0) //parameter
+	{
+		if (existingCC != nullptr) removeContainer(existingCC);
+
+		Controllable * newC = createControllableFromData(name, data);
+		if (existing != nullptr && newC != nullptr && canUpdateControllable(existing, newC))
+		{
+			updateControllable(existing, newC);
+			delete newC;
+			return;
+		}
+
+		if (existing != nullptr) cc->removeControllable(existing);
+		if (newC != nullptr) cc->addControllable(newC);
+	}
+}
+
+bool GenericOSCQueryModule::canUpdateControllable(Controllable * c, Controllable * newC)
+{
+	if (c->type != newC->type) return false;
+	if (c->type != Controllable::ENUM) return true;
+
+	//an enum is kept only if its options didn't change
+	EnumParameter * ep = (EnumParameter *)c;
+	EnumParameter * newEP = (EnumParameter *)newC;
+	if (ep->enumValues.size() != newEP->enumValues.size()) return false;
+	for (int i = 0; i < ep->enumValues.size(); i++) if (ep->enumValues[i]->key != newEP->enumValues[i]->key) return false;
+	return true;
+}
+
+void GenericOSCQueryModule::updateControllable(Controllable * c, Controllable * newC)
+{
+	if (c->niceName != newC->niceName) c->setNiceName(newC->niceName);
+	if (c->isControllableFeedbackOnly != newC->isControllableFeedbackOnly) c->setControllableFeedbackOnly(newC->isControllableFeedbackOnly);
+	if (c->type == Controllable::TRIGGER) return;
+
+	Parameter * p = (Parameter *)c;
+	Parameter * newP = (Parameter *)newC;
+	if (p->type != Controllable::ENUM && (p->minimumValue != newP->minimumValue || p->maximumValue != newP->maximumValue)) p->setRange(newP->minimumValue, newP->maximumValue);
+	p->setValue(newP->value);
 }
 
 Controllable * GenericOSCQueryModule::createControllableFromData(StringRef name, var data)
@@ -141,6 +251,8 @@ Controllable * GenericOSCQueryModule::createControllableFromData(StringRef name,
 	switch (type)
 	{
 	case 'N': c = new Trigger(cNiceName, cNiceName); break;
+	case 'T':
+	case 'F': c = new BoolParameter(cNiceName, cNiceName, value); break;
 	case 'i': c = new IntParameter(cNiceName, cNiceName, value, minVal, maxVal); break;
 	case 'f': c = new FloatParameter(cNiceName, cNiceName, value, minVal, maxVal); break;
 
@@ -196,8 +308,14 @@ void GenericOSCQueryModule::onControllableFeedbackUpdateInternal(ControllableCon
 	{
 		syncData();
 	}
+	else if (c == listenAll)
+	{
+		sendListenCommands();
+	}
 	else if (cc == &valuesCC)
 	{
+		//value received from the remote host, don't send it back. The tree is only updated on the message thread, values set meanwhile from other threads are still sent
+		if (MessageManager::getInstance()->isThisTheMessageThread() && isUpdatingTree) return;
 		sendOSCForControllable(c);
 	}
 }
@@ -205,7 +323,27 @@ void GenericOSCQueryModule::onControllableFeedbackUpdateInternal(ControllableCon
 void GenericOSCQueryModule::run()
 {
     if(useLocal == nullptr || remoteHost == nullptr || remotePort == nullptr) return;
-	URL url("http://" + (useLocal->boolValue()?"127.0.0.1":remoteHost->stringValue()) + ":" + remotePort->stringValue());
+
+	while (!threadShouldExit())
+	{
+		if (syncPending.exchange(false)) fetchData();
+
+		Array<PathUpdate> paths;
+		{
+			GenericScopedLock<SpinLock> lock(pendingPathsLock);
+			paths.swapWith(pendingPaths);
+		}
+
+		for (auto &p : paths) fetchNodeForPath(p);
+
+		//woken up by syncData and updateNodeForPath, a request made meanwhile is not lost
+		if (!syncPending && paths.isEmpty()) wait(-1);
+	}
+}
+
+void GenericOSCQueryModule::fetchData()
+{
+	URL url(getBaseURL());
 
 	StringPairArray responseHeaders;
 	int statusCode = 0;
@@ -231,11 +369,22 @@ void GenericOSCQueryModule::run()
 		var data = JSON::parse(content);
 		if (data.isObject())
 		{
-			createTreeFromData(data);
+			std::unique_ptr<InputStream> hostInfoStream(URL(getBaseURL() + "/?HOST_INFO").createInputStream(false, nullptr, nullptr, String(), 2000));
+			var hostInfo = hostInfoStream != nullptr ? JSON::parse(hostInfoStream->readEntireStreamAsString()) : var();
+
+			//the requests are made here, the tree is only modified from the message thread
+			WeakReference<Inspectable> ref(this);
+			MessageManager::callAsync([ref, this, data, hostInfo]()
+			{
+				if (ref.wasObjectDeleted()) return;
+				createTreeFromData(data);
+
+				Array<var> args;
+				args.add(data);
+				scriptManager->callFunctionOnAllItems(dataStructureEventId, args);
 
-			Array<var> args;
-			args.add(data);
-			scriptManager->callFunctionOnAllItems(dataStructureEventId, args);
+				setupWebSocket(hostInfo);
+			});
 		}
 	}
 	else
@@ -245,6 +394,287 @@ void GenericOSCQueryModule::run()
 
 }
 
+String GenericOSCQueryModule::getBaseURL()
+{
+	return "http://" + (useLocal->boolValue() ? "127.0.0.1" : remoteHost->stringValue()) + ":" + remotePort->stringValue();
+}
+
+void GenericOSCQueryModule::setupWebSocket(var hostInfo)
+{
+	var extensions = hostInfo.getProperty("EXTENSIONS", var());
+	if (extensions.isObject() && !(bool)extensions.getProperty("LISTEN", false) && !(bool)extensions.getProperty("PATH_ADDED", false))
+	{
+		wsClient->stop();
+		NLOG(niceName, "Remote host doesn't support LISTEN, values won't be updated from the remote host");
+		return;
+	}
+
+	String host = hostInfo.getProperty("WS_IP", "").toString();
+	if (host.isEmpty()) host = useLocal->boolValue() ? "127.0.0.1" : remoteHost->stringValue();
+	int port = hostInfo.getProperty("WS_PORT", remotePort->intValue());
+
+	if (wsClient->isThreadRunning() && wsClient->getHost() == host && wsClient->getPort() == port)
+	{
+		sendListenCommands();
+		return;
+	}
+
+	wsClient->start(host, port);
+}
+
+void GenericOSCQueryModule::listen(const String & address, bool shouldListen)
+{
+	{
+		GenericScopedLock<SpinLock> lock(listenLock);
+		if (shouldListen) listenedAddresses.addIfNotAlreadyThere(address);
+		else listenedAddresses.removeString(address);
+	}
+
+	wsClient->send(getCommandString(shouldListen ? "LISTEN" : "IGNORE", address));
+}
+
+void GenericOSCQueryModule::sendListenCommands()
+{
+	sendListenCommands(valuesCC.getAllControllables(true));
+}
+
+void GenericOSCQueryModule::sendListenCommands(Array<WeakReference<Controllable>> values)
+{
+	if (!wsClient->isConnected()) return;
+
+	StringArray addresses;
+	{
+		GenericScopedLock<SpinLock> lock(listenLock);
+		addresses = listenedAddresses;
+	}
+
+	bool all = listenAll->boolValue();
+	for (auto &c : values)
+	{
+		if (c.wasObjectDeleted()) continue;
+		String address = c->getControlAddress(&valuesCC);
+		wsClient->send(getCommandString(all || addresses.contains(address) ? "LISTEN" : "IGNORE", address));
+	}
+}
+
+void GenericOSCQueryModule::addNodeForPath(const String & path, var data)
+{
+	String parentPath = path.upToLastOccurrenceOf("/", false, false);
+	ControllableContainer * parentCC = parentPath.isEmpty() ? &valuesCC : valuesCC.getControllableContainerForAddress(parentPath, true);
+	if (parentCC == nullptr || !data.isObject())
+	{
+		//the parent is not known yet, fall back to a full sync
+		syncData();
+		return;
+	}
+
+	{
+		ScopedValueSetter<bool> updating(isUpdatingTree, true);
+		updateNodeFromData(parentCC, path.fromLastOccurrenceOf("/", false, false), data);
+	}
+
+	if (Controllable * c = valuesCC.getControllableForAddress(path)) sendListenCommands(Array<WeakReference<Controllable>>(WeakReference<Controllable>(c)));
+	else if (ControllableContainer * cc = valuesCC.getControllableContainerForAddress(path, true)) sendListenCommands(cc->getAllControllables(true));
+}
+
+void GenericOSCQueryModule::removeNodeForPath(const String & path)
+{
+	if (Controllable * c = valuesCC.getControllableForAddress(path))
+	{
+		c->parentContainer->removeControllable(c);
+		return;
+	}
+
+	ControllableContainer * cc = valuesCC.getControllableContainerForAddress(path, true);
+	if (cc != nullptr) removeContainer(cc);
+}
+
+void GenericOSCQueryModule::removeContainer(ControllableContainer * cc)
+{
+	if (cc->parentContainer == nullptr) return;
+
+	Array<ControllableContainer *> descendants;
+	for (auto &vc : valuesContainers)
+	{
+		for (ControllableContainer * p = vc->parentContainer; p != nullptr; p = p->parentContainer)
+		{
+			if (p == cc)
+			{
+				descendants.add(vc);
+				break;
+			}
+		}
+	}
+
+	cc->parentContainer->removeChildControllableContainer(cc);
+	valuesContainers.removeObject(cc);
+	for (auto &d : descendants) valuesContainers.removeObject(d);
+}
+
+void GenericOSCQueryModule::updateNodeForPath(const String & path, const String & oldPath)
+{
+	{
+		GenericScopedLock<SpinLock> lock(pendingPathsLock);
+		pendingPaths.add({ path, oldPath });
+	}
+
+	startThread();
+	notify();
+}
+
+void GenericOSCQueryModule::fetchNodeForPath(const PathUpdate & update)
+{
+	//the node is fetched here, the tree is only modified from the message thread
+	var data;
+	if (update.path.isNotEmpty())
+	{
+		std::unique_ptr<InputStream> stream(URL(getBaseURL() + update.path).createInputStream(false, nullptr, nullptr, String(), 2000));
+		if (stream != nullptr) data = JSON::parse(stream->readEntireStreamAsString());
+	}
+
+	String path = update.path;
+	String oldPath = update.oldPath;
+	WeakReference<Inspectable> ref(this);
+	MessageManager::callAsync([ref, this, path, oldPath, data]()
+	{
+		if (ref.wasObjectDeleted()) return;
+		if (oldPath.isNotEmpty()) removeNodeForPath(oldPath);
+		if (data.isObject()) addNodeForPath(path, data); //diffed against the existing node if there is one
+		else removeNodeForPath(path);
+	});
+}
+
+void GenericOSCQueryModule::applyRemoteValues(const OSCBundle::Element & e)
+{
+	if (e.isBundle())
+	{
+		for (auto &child : e.getBundle()) applyRemoteValues(child);
+		return;
+	}
+
+	const OSCMessage &m = e.getMessage();
+	Controllable * c = valuesCC.getControllableForAddress(m.getAddressPattern().toString());
+	if (c == nullptr) return;
+
+	if (logIncomingData->boolValue()) NLOG(niceName, "Value update : " << m.getAddressPattern().toString());
+
+	if (c->type == Controllable::TRIGGER)
+	{
+		((Trigger *)c)->trigger();
+		return;
+	}
+
+	if (m.isEmpty()) return;
+
+	Parameter * p = (Parameter *)c;
+	const OSCArgument &a = m[0];
+	if (p->type == Controllable::COLOR)
+	{
+		if (!a.isColour()) return;
+		OSCColour col = a.getColour();
+		((ColorParameter *)p)->setColor(Colour(col.red, col.green, col.blue, col.alpha));
+	}
+	else if (a.isFloat32()) p->setValue(a.getFloat32());
+	else if (a.isInt32()) p->setValue(a.getInt32());
+	else if (a.isString()) p->setValue(a.getString());
+}
+
+void GenericOSCQueryModule::connectionOpened()
+{
+	NLOG(niceName, "Listening to " << wsClient->getHost() << ":" << wsClient->getPort());
+	isListening->setValue(true);
+
+	WeakReference<Inspectable> ref(this);
+	MessageManager::callAsync([ref, this]()
+	{
+		if (!ref.wasObjectDeleted()) sendListenCommands();
+	});
+}
+
+void GenericOSCQueryModule::connectionClosed()
+{
+	isListening->setValue(false);
+}
+
+void GenericOSCQueryModule::messageReceived(const String & message)
+{
+	if (logIncomingData->boolValue()) NLOG(niceName, "Received : " << message);
+	inActivityTrigger->trigger();
+
+	var data = JSON::parse(message);
+	String command = data.getProperty("COMMAND", "").toString();
+	var commandData = data.getProperty("DATA", var());
+
+	if (command == "PATH_ADDED" || command == "PATH_CHANGED") updateNodeForPath(commandData.toString());
+	else if (command == "PATH_RENAMED") updateNodeForPath(commandData.getProperty("NEW", "").toString(), commandData.getProperty("OLD", "").toString());
+	else if (command == "PATH_REMOVED")
+	{
+		String path = commandData.toString();
+		WeakReference<Inspectable> ref(this);
+		MessageManager::callAsync([ref, this, path]()
+		{
+			if (!ref.wasObjectDeleted()) removeNodeForPath(path);
+		});
+	}
+}
+
+void GenericOSCQueryModule::dataReceived(const MemoryBlock & data)
+{
+	inActivityTrigger->trigger();
+
+	try
+	{
+		OSCBundle::Element e = OSCPacketCodec::readPacket(data.getData(), data.getSize());
+
+		//updates received until the message thread applies them are applied together
+		GenericScopedLock<SpinLock> lock(pendingValuesLock);
+		pendingValues.add(e);
+	}
+	catch (OSCFormatError &e)
+	{
+		NLOGERROR(niceName, "Error reading value update : " << e.description);
+		return;
+	}
+
+	if (valuesUpdatePending.exchange(true)) return;
+
+	WeakReference<Inspectable> ref(this);
+	MessageManager::callAsync([ref, this]()
+	{
+		if (!ref.wasObjectDeleted()) applyPendingValues();
+	});
+}
+
+void GenericOSCQueryModule::applyPendingValues()
+{
+	valuesUpdatePending = false;
+
+	Array<OSCBundle::Element> values;
+	{
+		GenericScopedLock<SpinLock> lock(pendingValuesLock);
+		values.swapWith(pendingValues);
+	}
+
+	ScopedValueSetter<bool> updating(isUpdatingTree, true);
+	for (auto &e : values) applyRemoteValues(e);
+}
+
+var GenericOSCQueryModule::listenFromScript(const var::NativeFunctionArgs & a)
+{
+	GenericOSCQueryModule * m = getObjectFromJS<GenericOSCQueryModule>(a);
+	if (a.numArguments == 0) return var();
+	m->listen(a.arguments[0].toString(), true);
+	return var();
+}
+
+var GenericOSCQueryModule::ignoreFromScript(const var::NativeFunctionArgs & a)
+{
+	GenericOSCQueryModule * m = getObjectFromJS<GenericOSCQueryModule>(a);
+	if (a.numArguments == 0) return var();
+	m->listen(a.arguments[0].toString(), false);
+	return var();
+}
+
 
 OSCQueryOutput::OSCQueryOutput(GenericOSCQueryModule * module) :
 	EnablingControllableContainer("Output"),
@@ -11,6 +11,7 @@
 #pragma once
 
 #include "Module/Module.h"
+#include "Common/WebSocket/WebSocketClient.h"
 
 class GenericOSCQueryModule;
 class OSCQueryOutput :
@@ -26,7 +27,8 @@ public:
 
 class GenericOSCQueryModule :
 	public Module,
-	public Thread
+	public Thread,
+	public WebSocketClient::Listener
 {
 public:
 	GenericOSCQueryModule(const String &name = "OSCQuery",int defaultRemotePort = 5678);
@@ -35,6 +37,8 @@ public:
 	const Identifier dataStructureEventId = "dataStructureEvent";
 
 	Trigger * syncTrigger;
+	BoolParameter * listenAll;
+	BoolParameter * isListening;
 
 	std::unique_ptr<OSCQueryOutput> sendCC;
 	BoolParameter * useLocal;
@@ -47,6 +51,31 @@ public:
 	ValueTree dataTree;
 
 	OwnedArray<ControllableContainer> valuesContainers;
+	bool isUpdatingTree; //message thread only : values set while updating the tree come from the remote host, they're not sent back
+
+	//LISTEN : the remote host streams the changes of listened values and of the namespace over a WebSocket
+	std::unique_ptr<WebSocketClient> wsClient;
+	SpinLock listenLock;
+	StringArray listenedAddresses;
+
+	//value updates are decoded on the WebSocket thread and applied on the message thread, like every change of the tree
+	SpinLock pendingValuesLock;
+	Array<OSCBundle::Element> pendingValues;
+	std::atomic<bool> valuesUpdatePending;
+
+	//full syncs and namespace changes are fetched on the module thread, so the WebSocket thread never waits for an HTTP request
+	struct PathUpdate
+	{
+		String path;
+		String oldPath;
+	};
+
+	std::atomic<bool> syncPending;
+	SpinLock pendingPathsLock;
+	Array<PathUpdate> pendingPaths;
+
+	const Identifier listenId = "listen";
+	const Identifier ignoreId = "ignore";
 
 	void sendOSCMessage(OSCMessage m);
 	void sendOSCForControllable(Controllable * c);
@@ -55,6 +84,36 @@ public:
 	virtual void createTreeFromData(var data);
 	virtual void fillContainerFromData(ControllableContainer * cc, var data);
 	virtual Controllable * createControllableFromData(StringRef name, var data);
+	virtual void addNodeFromData(ControllableContainer * cc, const String &name, var data);
+
+	//structural diff : existing controllables are kept and updated when their type allows it, so mappings and commands keep their links
+	virtual void updateContainerFromData(ControllableContainer * cc, var data);
+	virtual void updateNodeFromData(ControllableContainer * cc, const String &name, var data);
+	virtual bool canUpdateControllable(Controllable * c, Controllable * newC);
+	virtual void updateControllable(Controllable * c, Controllable * newC);
+	void removeContainer(ControllableContainer * cc);
+
+	String getBaseURL();
+	void setupWebSocket(var hostInfo);
+	void listen(const String &address, bool shouldListen);
+	void sendListenCommands();
+	void sendListenCommands(Array<WeakReference<Controllable>> values);
+
+	void addNodeForPath(const String &path, var data);
+	void removeNodeForPath(const String &path);
+	void updateNodeForPath(const String &path, const String &oldPath = String());
+	void fetchData();
+	void fetchNodeForPath(const PathUpdate &update);
+	void applyRemoteValues(const OSCBundle::Element &e);
+	void applyPendingValues();
+
+	void connectionOpened() override;
+	void connectionClosed() override;
+	void messageReceived(const String &message) override;
+	void dataReceived(const MemoryBlock &data) override;
+
+	static var listenFromScript(const var::NativeFunctionArgs &a);
+	static var ignoreFromScript(const var::NativeFunctionArgs &a);
 
 	virtual void onControllableFeedbackUpdateInternal(ControllableContainer * cc, Controllable * c) override;
 
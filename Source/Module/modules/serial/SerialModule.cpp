@@ -155,14 +155,19 @@ void SerialModule::serialDataReceived(const var & data)
 	{
 
 	case SerialDevice::LINES:
-		processDataLine(data.toString());
-		break;
+	{
+		String line = data.toString();
+		postInput([this, line]() { processDataLine(line); });
+	}
+	break;
 
 	case SerialDevice::DATA255:
 	case SerialDevice::RAW:
 	case SerialDevice::COBS:
-		Array<uint8> bytes((const uint8_t *)data.getBinaryData()->getData(), (int)data.getBinaryData()->getSize());
-		processDataBytes(bytes);
+	{
+		Array<uint8> bytes((const uint8_t*)data.getBinaryData()->getData(), (int)data.getBinaryData()->getSize());
+		postInput([this, bytes]() { processDataBytes(bytes); });
+	}
 	break;
 
 	}
@@ -10,10 +10,25 @@
 
 #include "TCPClientModule.h"
 
+#if JUCE_WINDOWS
+#include <winsock2.h>
+#else
+#include <sys/socket.h>
+#include <sys/time.h>
+#endif
+
 TCPClientModule::TCPClientModule(const String & name, int defaultRemotePort) :
 	NetworkStreamingModule(name,false, true, 0, defaultRemotePort)
 {
 	connectionFeedbackRef = senderIsConnected;
+	receiveFrequency->hideInEditor = true; //the connection thread waits for incoming data instead of polling
+
+	queuedBytes = sendCC->addIntParameter("Queued Bytes", "Number of bytes waiting to be sent to the server", 0, 0, maxQueuedBytes);
+	queuedBytes->setControllableFeedbackOnly(true);
+	queuedBytes->isSavable = false;
+	reconnectAttempts = sendCC->addIntParameter("Reconnect Attempts", "Number of failed connection attempts since the last successful connection", 0, 0);
+	reconnectAttempts->setControllableFeedbackOnly(true);
+	reconnectAttempts->isSavable = false;
 
 	setupIOConfiguration(true, true);
 
@@ -21,12 +36,11 @@ TCPClientModule::TCPClientModule(const String & name, int defaultRemotePort) :
 	{
 		setupSender();
 	}
-
-	startTimerHz(1);
 }
 
 TCPClientModule::~TCPClientModule()
 {
+	clearThread();
 }
 
 void TCPClientModule::setupSender()
@@ -45,53 +59,27 @@ void TCPClientModule::setupSender()
 
 	if (Engine::mainEngine != nullptr && Engine::mainEngine->isClearing) return;
 
+	reconnectAttempts->setValue(0);
 	startThread();
 }
 
-void TCPClientModule::initThread()
-{
-	//if (sender.isConnected()) sender.close();
-
-	if (!enabled->boolValue()) return;
-
-	String targetHost = useLocal->boolValue() ? "127.0.0.1" : remoteHost->stringValue();
-	bool result = sender.connect(targetHost, remotePort->intValue(), 200);
-	if(result) NLOG(niceName, "Sender bound to port " << sender.getBoundPort());
-	senderIsConnected->setValue(result);
-
-	if (result)
-	{
-		NLOG(niceName, "Client is connected to " << remoteHost->stringValue() << ":" << remotePort->intValue());
-		sendCC->clearWarning();
-		startThread();
-	}
-	else
-	{
-		String s = "Could not connect to " + remoteHost->stringValue() + ":" + remotePort->stringValue();
-		if(getWarningMessage().isEmpty()) NLOGERROR(niceName, s);
-		sendCC->setWarningMessage(s);
-	}
-
-}
-
 void TCPClientModule::clearThread()
 {
-	NetworkStreamingModule::clearThread();
-	if (sender.isConnected()) sender.close();
-}
+	signalThreadShouldExit();
+	notify(); //wake the thread up if it is waiting before reconnecting
 
-bool TCPClientModule::checkReceiverIsReady()
-{
-	if (!senderIsConnected->boolValue()) return false;
-	int result = sender.waitUntilReady(true, 100);
-	
-	if(result == -1)
+	//a write in progress can block up to sendTimeoutMs, shutting the socket down makes it return right away
+	if (sender.isConnected())
 	{
-		senderIsConnected->setValue(false);
-		return false;
+#if JUCE_WINDOWS
+		::shutdown(sender.getRawSocketHandle(), SD_BOTH);
+#else
+		::shutdown(sender.getRawSocketHandle(), SHUT_RDWR);
+#endif
 	}
 
-	return result == 1;
+	waitForThreadToExit(sendTimeoutMs + connectTimeoutMs); //the longest the thread can be blocked in a socket call
+	disconnectSender();
 }
 
 bool TCPClientModule::isReadyToSend()
@@ -101,46 +89,157 @@ bool TCPClientModule::isReadyToSend()
 
 void TCPClientModule::sendMessageInternal(const String & message)
 {
-	int numBytes = sender.write(message.getCharPointer(), message.length());
-	if (numBytes == -1)
-	{
-		NLOGERROR(niceName, "Error sending message");
-		senderIsConnected->setValue(false);
-	}
+	queueData(message.toRawUTF8(), message.getNumBytesAsUTF8());
 }
 
 void TCPClientModule::sendBytesInternal(Array<uint8> data)
 {
-	int numBytes = sender.write(data.getRawDataPointer(), data.size());
-	if (numBytes == -1)
+	queueData(data.getRawDataPointer(), (size_t)data.size());
+}
+
+void TCPClientModule::queueData(const void * data, size_t numBytes)
+{
+	queueLock.enter();
+	bool isFull = pendingData.getSize() + numBytes > (size_t)maxQueuedBytes;
+	if (!isFull) pendingData.append(data, numBytes);
+	int numQueued = (int)pendingData.getSize();
+	queueLock.exit();
+
+	if (isFull)
 	{
-		NLOGERROR(niceName, "Error sending data");
-		senderIsConnected->setValue(false);
+		NLOGWARNING(niceName, "Send queue is full, the server doesn't take data fast enough. Dropping data");
+		return;
 	}
+
+	queuedBytes->setValue(numQueued);
+	notify();
 }
 
-Array<uint8> TCPClientModule::readBytes()
+bool TCPClientModule::connectSender()
 {
-	uint8 bytes[2048];
-	int numRead = sender.read(bytes, 2048, false);
+	String targetHost = useLocal->boolValue() ? "127.0.0.1" : remoteHost->stringValue();
+	bool result = sender.connect(targetHost, remotePort->intValue(), connectTimeoutMs);
 
-	if (numRead == 0)
+	if (result)
 	{
-		NLOGWARNING(niceName, "Connection to TCP Server seems lost, disconnecting");
-		senderIsConnected->setValue(false);
+		//writes are done on the connection thread, but still shouldn't hang forever on a dead peer
+#if JUCE_WINDOWS
+		DWORD timeout = sendTimeoutMs;
+#else
+		timeval timeout;
+		timeout.tv_sec = sendTimeoutMs / 1000;
+		timeout.tv_usec = (sendTimeoutMs % 1000) * 1000;
+#endif
+		setsockopt(sender.getRawSocketHandle(), SOL_SOCKET, SO_SNDTIMEO, (const char *)&timeout, sizeof(timeout));
+
+		NLOG(niceName, "Client is connected to " << targetHost << ":" << remotePort->intValue());
+		sendCC->clearWarning();
+		reconnectAttempts->setValue(0);
+	}
+	else
+	{
+		String s = "Could not connect to " + targetHost + ":" + remotePort->stringValue();
+		if (sendCC->getWarningMessage().isEmpty()) NLOGERROR(niceName, s);
+		sendCC->setWarningMessage(s);
 	}
 
-	return Array<uint8>(bytes, numRead);
+	senderIsConnected->setValue(result);
+	return result;
 }
 
-void TCPClientModule::clearInternal()
+void TCPClientModule::disconnectSender()
 {
 	if (sender.isConnected()) sender.close();
+	senderIsConnected->setValue(false);
+	clearSendQueue();
 }
 
+void TCPClientModule::clearSendQueue()
+{
+	queueLock.enter();
+	size_t numDropped = pendingData.getSize();
+	pendingData.reset();
+	queueLock.exit();
+
+	if (numDropped > 0) NLOGWARNING(niceName, "Connection closed, " << (int)numDropped << " queued bytes were not sent");
+	queuedBytes->setValue(0);
+}
+
+void TCPClientModule::clearInternal()
+{
+	disconnectSender();
+}
 
-void TCPClientModule::timerCallback()
+void TCPClientModule::run()
 {
-	if (!sender.isConnected()) senderIsConnected->setValue(false);
-	if(!senderIsConnected->boolValue()) setupSender();
+	if (Engine::mainEngine != nullptr && Engine::mainEngine->isClearing) return;
+
+	StreamBuffer buffer;
+	MemoryBlock dataToWrite;
+	uint8 bytes[2048];
+	int reconnectDelay = minReconnectDelayMs;
+
+	while (!threadShouldExit())
+	{
+		if (!senderIsConnected->boolValue())
+		{
+			if (connectSender())
+			{
+				reconnectDelay = minReconnectDelayMs;
+				buffer = StreamBuffer();
+				dataToWrite.setSize(0); //the end of a message cut by the lost connection would be meaningless on the new one
+				continue;
+			}
+
+			reconnectAttempts->setValue(reconnectAttempts->intValue() + 1);
+			wait(reconnectDelay);
+			reconnectDelay = jmin(reconnectDelay * 2, maxReconnectDelayMs);
+			continue;
+		}
+
+		//everything queued since the last loop is written at once, after what the last write didn't send
+		queueLock.enter();
+		if (dataToWrite.getSize() == 0) dataToWrite.swapWith(pendingData);
+		else
+		{
+			dataToWrite.append(pendingData.getData(), pendingData.getSize());
+			pendingData.setSize(0);
+		}
+		queueLock.exit();
+
+		if (dataToWrite.getSize() > 0)
+		{
+			int numWritten = sender.write(dataToWrite.getData(), (int)dataToWrite.getSize());
+
+			//a write stopped by the send timeout returns what it could send, the rest is written first on the next loop
+			if (numWritten <= 0)
+			{
+				NLOGERROR(niceName, "Error sending data, disconnecting, " << (int)dataToWrite.getSize() << " bytes were not sent");
+				dataToWrite.setSize(0);
+				disconnectSender();
+				wait(minReconnectDelayMs);
+				continue;
+			}
+
+			dataToWrite.removeSection(0, (size_t)numWritten);
+			queuedBytes->setValue((int)dataToWrite.getSize());
+		}
+
+		//incoming data is read as soon as it arrives, the wait is short so queued data doesn't wait either
+		int ready = sender.waitUntilReady(true, dataToWrite.getSize() > 0 ? 0 : readWaitMs);
+		if (ready == 0) continue;
+
+		int numRead = ready == 1 ? sender.read(bytes, 2048, false) : -1;
+		if (numRead <= 0)
+		{
+			NLOGWARNING(niceName, "Connection to TCP Server seems lost, disconnecting");
+			disconnectSender();
+			wait(minReconnectDelayMs);
+			continue;
+		}
+
+		processReceivedBytes(buffer, bytes, numRead);
+	}
+
+	DBG("Exit thread");
 }
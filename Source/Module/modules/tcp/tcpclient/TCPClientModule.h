@@ -13,8 +13,7 @@
 #include "../../common/streaming/NetworkStreamingModule.h"
 
 class TCPClientModule :
-	public NetworkStreamingModule,
-	public Timer
+	public NetworkStreamingModule
 {
 public:
 	TCPClientModule(const String &name = "TCP Client", int defaultRemotePort = 5001);
@@ -22,23 +21,37 @@ public:
 
 	StreamingSocket sender;
 
+	IntParameter * queuedBytes;
+	IntParameter * reconnectAttempts;
+
+	//outgoing data is queued by the callers and written by the connection thread, so a dead peer never blocks them
+	CriticalSection queueLock;
+	MemoryBlock pendingData;
+
+	static const int maxQueuedBytes = 1 << 20;
+	static const int connectTimeoutMs = 500;
+	static const int sendTimeoutMs = 2000; //a peer that doesn't take our data for that long is considered lost
+	static const int readWaitMs = 5; //longest wait for incoming data before writing what has been queued meanwhile
+	static const int minReconnectDelayMs = 500;
+	static const int maxReconnectDelayMs = 16000;
+
 	virtual void setupSender() override;
-	virtual void initThread() override;
 	virtual void clearThread() override;
 
-	virtual bool checkReceiverIsReady() override;
 	virtual bool isReadyToSend() override;
 
 	virtual void sendMessageInternal(const String &message) override;
 	virtual void sendBytesInternal(Array<uint8> data) override;
+	void queueData(const void * data, size_t numBytes);
+
+	bool connectSender();
+	void disconnectSender();
+	void clearSendQueue();
 
-	virtual Array<uint8> readBytes() override;
-	
 	virtual void clearInternal() override;
 
+	virtual void run() override;
+
 	static TCPClientModule * create() { return new TCPClientModule(); }
 	virtual String getDefaultTypeString() const override { return "TCP Client"; }
-
-	// Inherited via Timer
-	virtual void timerCallback() override;
 };
\ No newline at end of file
@@ -32,9 +32,12 @@ void TCPServerConnectionManager::setupReceiver(int port)
 void TCPServerConnectionManager::removeConnection(StreamingSocket* connection)
 {
 	connectionLock.enter();
+	bool wasConnected = connections.contains(connection);
 	connections.removeObject(connection, false);
 	connectionLock.exit();
 
+	if (!wasConnected) return; //already removed, i.e. by both the receiving and the sending side
+
 	connectionManagerListeners.call(&ConnectionManagerListener::connectionRemoved, connection);
 	queuedNotifier.addMessage(new ConnectionManagerEvent(ConnectionManagerEvent::CONNECTIONS_CHANGED));
 
@@ -64,7 +67,9 @@ void TCPServerConnectionManager::run()
 			StreamingSocket* socket = receiver.waitForNextConnection();
 			if (socket != nullptr)
 			{
+				connectionLock.enter();
 				connections.add(socket);
+				connectionLock.exit();
 				connectionManagerListeners.call(&ConnectionManagerListener::newConnection, socket);
 				queuedNotifier.addMessage(new ConnectionManagerEvent(ConnectionManagerEvent::CONNECTIONS_CHANGED));
 			}
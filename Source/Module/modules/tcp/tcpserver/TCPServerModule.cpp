@@ -11,13 +11,58 @@
 #include "TCPServerModule.h"
 #include "ui/TCPServerModuleUI.h"
 
+#if JUCE_WINDOWS
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#if JUCE_LINUX
+#include <sys/epoll.h>
+#else
+#include <poll.h>
+#endif
+#endif
+
+#if !JUCE_LINUX
+namespace
+{
+	int pollSockets(pollfd* handles, int numHandles, int timeoutMs)
+	{
+#if JUCE_WINDOWS
+		return WSAPoll(handles, (ULONG)numHandles, timeoutMs);
+#else
+		return poll(handles, (nfds_t)numHandles, timeoutMs);
+#endif
+	}
+}
+#endif
+
 TCPServerModule::TCPServerModule(const String& name, int defaultLocalPort) :
 	NetworkStreamingModule(name, true, false, 6000)
 {
 	numClients = moduleParams.addIntParameter("Num Clients", "Number of connected clients", 0, 0, 1000);
 	numClients->setControllableFeedbackOnly(true);
+	lastClient = moduleParams.addStringParameter("Last Client", "The client that sent the last received message, as ip:port", "");
+	lastClient->setControllableFeedbackOnly(true);
+	lastClient->isSavable = false;
+	sendTarget = moduleParams.addEnumParameter("Send To", "Choose whether to send to all connected clients, or only to reply to the client that sent the last message");
+	sendTarget->addOption("All Clients", ALL_CLIENTS)->addOption("Last Client", LAST_CLIENT);
 	setupIOConfiguration(true, true);
 
+	receiveFrequency->hideInEditor = true; //clients are read as soon as they have data
+	readBuffer.allocate(readBufferSize, false);
+
+#if JUCE_LINUX
+	epollHandle = -1;
+#endif
+
+	scriptObject.setMethod(sendToId, TCPServerModule::sendToFromScript);
+	scriptObject.setMethod(sendBytesToId, TCPServerModule::sendBytesToFromScript);
+	scriptObject.setMethod(getClientsId, TCPServerModule::getClientsFromScript);
+
 	receiveCC->canBeDisabled = false;
 	connectionManager.addConnectionManagerListener(this);
 
@@ -26,6 +71,7 @@ TCPServerModule::TCPServerModule(const String& name, int defaultLocalPort) :
 
 TCPServerModule::~TCPServerModule()
 {
+	clearThread(); //the receiving thread uses the client streams, stop it before they are destroyed
 }
 
 void TCPServerModule::setupReceiver()
@@ -64,94 +110,182 @@ bool TCPServerModule::isReadyToSend()
 
 void TCPServerModule::sendMessageInternal(const String& message)
 {
-	if (connectionManager.connections.size() == 0)
-	{
-		NLOGWARNING(niceName, "No active connections in this TCP Server, message will be lost in space");
-		return;
-	}
+	writeToClients(message.toRawUTF8(), (int)message.getNumBytesAsUTF8());
+}
+
+void TCPServerModule::sendBytesInternal(Array<uint8> data)
+{
+	writeToClients(data.getRawDataPointer(), data.size());
+}
+
+void TCPServerModule::sendToClient(const String& clientId, const String& message)
+{
+	ScopedValueSetter<String> target(targetClient.get(), clientId);
+	sendMessage(message);
+}
+
+void TCPServerModule::sendBytesToClient(const String& clientId, Array<uint8> data)
+{
+	ScopedValueSetter<String> target(targetClient.get(), clientId);
+	sendBytes(data);
+}
+
+void TCPServerModule::writeToClients(const void* data, int numBytes)
+{
+	String target = targetClient.get();
+	if (target.isEmpty() && sendTarget->getValueDataAsEnum<SendTarget>() == LAST_CLIENT) target = lastClient->stringValue();
 
 	Array<StreamingSocket*> connectionsToRemove;
+	int numSent = 0;
 
-	connectionManager.connectionLock.enter();
+	ReferenceCountedArray<ClientStream> targetClients;
+	clientsLock.enter();
+	for (auto& c : clients) if (target.isEmpty() || c->id == target) targetClients.add(c);
+	clientsLock.exit();
 
-	for (auto& c : connectionManager.connections)
+	//a blocking write doesn't hold clientsLock, the receiving thread and new connections go on meanwhile
+	for (auto& c : targetClients)
 	{
-		int numBytes = c->write(message.getCharPointer(), message.length());
-		if (numBytes == -1) connectionsToRemove.add(c);
+		const ScopedLock wl(c->writeLock);
+		if (c->socket == nullptr) continue; //removed meanwhile
+		if (c->socket->write(data, numBytes) == -1) connectionsToRemove.add(c->socket);
+		else numSent++;
 	}
 
-	connectionManager.connectionLock.exit();
+	if (numSent == 0 && connectionsToRemove.isEmpty())
+	{
+		if (target.isEmpty()) NLOGWARNING(niceName, "No active connections in this TCP Server, message will be lost in space");
+		else NLOGWARNING(niceName, "Client " << target << " is not connected, message will be lost in space");
+	}
 
 	for (auto& c : connectionsToRemove)
 	{
-		NLOGERROR(niceName, "Error sending message, removing client");
+		NLOGERROR(niceName, "Error sending data, removing client");
 		connectionManager.removeConnection(c);
-		numClients->setValue(connectionManager.connections.size());
 	}
 }
 
-void TCPServerModule::sendBytesInternal(Array<uint8> data)
+StringArray TCPServerModule::getClientIds()
 {
-	if (connectionManager.connections.size() == 0)
-	{
-		NLOGWARNING(niceName, "No active connections in this TCP Server, message will be lost in space");
-		return;
-	}
-	
-	for (auto& c : connectionManager.connections)
-	{
-		int numBytes = c->write(data.getRawDataPointer(), data.size());
-		if (numBytes == -1)
-		{
-			NLOGERROR(niceName, "Error sending data, removing client");
-			connectionManager.removeConnection(c);
-			numClients->setValue(connectionManager.connections.size());
-		}
-	}
+	StringArray result;
+	const ScopedLock sl(clientsLock);
+	for (auto& c : clients) result.add(c->id);
+	return result;
 }
 
-Array<uint8> TCPServerModule::readBytes()
+String TCPServerModule::getClientId(StreamingSocket* s)
 {
-	Array<uint8> result;
-	
-	Array<StreamingSocket*> connectionsToRemove;
+	//accepted sockets only know the server port, the peer port is what tells apart clients from the same host
+	sockaddr_in address;
+	socklen_t addressLength = sizeof(address);
+	if (getpeername(s->getRawSocketHandle(), (sockaddr*)&address, &addressLength) == 0) return s->getHostName() + ":" + String(ntohs(address.sin_port));
+	return s->getHostName() + ":" + String(s->getRawSocketHandle());
+}
+
+void TCPServerModule::setInputSource(const String& source)
+{
+	lastClient->setValue(source);
+}
 
-	connectionManager.connectionLock.enter();
+void TCPServerModule::run()
+{
+	if (Engine::mainEngine != nullptr && Engine::mainEngine->isClearing) return;
 
-	for (auto& c : connectionManager.connections)
+#if JUCE_LINUX
+	clientsLock.enter();
+	epollHandle = epoll_create1(0);
+	for (auto& c : clients)
 	{
-		uint8 bytes[2048];
+		epoll_event e;
+		zerostruct(e);
+		e.events = EPOLLIN;
+		e.data.fd = c->socket->getRawSocketHandle();
+		epoll_ctl(epollHandle, EPOLL_CTL_ADD, e.data.fd, &e);
+	}
+	clientsLock.exit();
+#endif
 
-		int ready = c->waitUntilReady(true, 20);
-		if (ready == -1)
-		{
-			connectionsToRemove.add(c);
-			continue;
-		}
+	Array<int> readyHandles;
+	Array<StreamingSocket*> connectionsToRemove;
+
+	while (!threadShouldExit())
+	{
+		readyHandles.clearQuick();
+		waitForReadyClients(readyHandles, 100);
+		if (readyHandles.isEmpty()) continue;
 
-		if (ready == 1)
+		try
 		{
-			int numRead = c->read(bytes, 2048, false);
-			if (numRead <= 0)
+			const ScopedLock sl(clientsLock);
+			for (auto& h : readyHandles)
 			{
-				connectionsToRemove.add(c);
-				continue;
+				if (ClientStream* c = clientsByHandle[h]) readClient(c, connectionsToRemove);
 			}
+		}
+		catch (...)
+		{
+			DBG("### TCP Server receive thread problem ");
+		}
 
-			DBG("Num read : " << numRead);
-			result.addArray(Array<uint8>(bytes, numRead)); //Not that great, all values will be stacked together. Needs proper handling
+		for (auto& c : connectionsToRemove)
+		{
+			NLOGWARNING(niceName, "Connection to TCP client seems lost, removing client");
+			connectionManager.removeConnection(c);
 		}
+		connectionsToRemove.clearQuick();
 	}
 
-	connectionManager.connectionLock.exit();
+#if JUCE_LINUX
+	clientsLock.enter();
+	::close(epollHandle);
+	epollHandle = -1;
+	clientsLock.exit();
+#endif
 
-	for (auto& c : connectionsToRemove)
+	DBG("Exit thread");
+}
+
+void TCPServerModule::waitForReadyClients(Array<int>& readyHandles, int timeoutMs)
+{
+#if JUCE_LINUX
+	epoll_event events[64];
+	int numEvents = epoll_wait(epollHandle, events, 64, timeoutMs);
+	for (int i = 0; i < numEvents; i++) readyHandles.add(events[i].data.fd);
+#else
+	std::vector<pollfd> handles;
+	clientsLock.enter();
+	for (auto& c : clients)
 	{
-		NLOGWARNING(niceName, "Connection to TCP client seems lost, removing client");
-		connectionManager.removeConnection(c);
+		pollfd p;
+		p.fd = c->socket->getRawSocketHandle();
+		p.events = POLLIN;
+		p.revents = 0;
+		handles.push_back(p);
 	}
+	clientsLock.exit();
 
-	return result;
+	if (handles.empty())
+	{
+		wait(timeoutMs);
+		return;
+	}
+
+	if (pollSockets(handles.data(), (int)handles.size(), timeoutMs) <= 0) return;
+	for (auto& p : handles) if (p.revents != 0) readyHandles.add((int)p.fd);
+#endif
+}
+
+void TCPServerModule::readClient(ClientStream* c, Array<StreamingSocket*>& connectionsToRemove)
+{
+	//the socket was reported readable so this doesn't block, what is left will be reported again on next wait
+	int numRead = c->socket->read(readBuffer, readBufferSize, false);
+	if (numRead <= 0)
+	{
+		connectionsToRemove.addIfNotAlreadyThere(c->socket);
+		return;
+	}
+
+	processReceivedBytes(c->buffer, readBuffer, numRead, c->id);
 }
 
 void TCPServerModule::clearInternal()
@@ -162,14 +296,61 @@ void TCPServerModule::clearInternal()
 
 void TCPServerModule::newConnection(StreamingSocket* s)
 {
+	ClientStream* c = new ClientStream(s, getClientId(s));
+
+	clientsLock.enter();
+	clients.add(c);
+	clientsByHandle.set(s->getRawSocketHandle(), c);
+#if JUCE_LINUX
+	if (epollHandle >= 0)
+	{
+		epoll_event e;
+		zerostruct(e);
+		e.events = EPOLLIN;
+		e.data.fd = s->getRawSocketHandle();
+		epoll_ctl(epollHandle, EPOLL_CTL_ADD, e.data.fd, &e);
+	}
+#endif
+	clientsLock.exit();
+
 	numClients->setValue(connectionManager.connections.size());
-	NLOG(niceName, "New Client connected : " << s->getHostName() << ":" << s->getPort());
+	NLOG(niceName, "New Client connected : " << c->id);
 }
 
 void TCPServerModule::connectionRemoved(StreamingSocket* s)
 {
+	String id = s->getHostName();
+	ClientStream::Ptr removedClient;
+
+	clientsLock.enter();
+	for (auto& c : clients)
+	{
+		if (c->socket != s) continue;
+		id = c->id;
+#if JUCE_LINUX
+		if (epollHandle >= 0) epoll_ctl(epollHandle, EPOLL_CTL_DEL, s->getRawSocketHandle(), nullptr);
+#endif
+		clientsByHandle.remove(s->getRawSocketHandle());
+		removedClient = c;
+		clients.removeObject(c);
+		break;
+	}
+	clientsLock.exit();
+
+	if (removedClient != nullptr)
+	{
+		//the socket is deleted after this call : unblock a write in progress on another thread and wait for it to return
+#if JUCE_WINDOWS
+		::shutdown(s->getRawSocketHandle(), SD_BOTH);
+#else
+		::shutdown(s->getRawSocketHandle(), SHUT_RDWR);
+#endif
+		const ScopedLock wl(removedClient->writeLock);
+		removedClient->socket = nullptr;
+	}
+
 	numClients->setValue(connectionManager.connections.size());
-	NLOG(niceName, "Connection removed : " << s->getHostName() << ":" << s->getPort());
+	NLOG(niceName, "Connection removed : " << id);
 }
 
 void TCPServerModule::receiverBindChanged(bool isBound)
@@ -192,3 +373,41 @@ ModuleUI* TCPServerModule::getModuleUI()
 {
 	return new TCPServerModuleUI(this);
 }
+
+var TCPServerModule::sendToFromScript(const var::NativeFunctionArgs& a)
+{
+	TCPServerModule* m = getObjectFromJS<TCPServerModule>(a);
+	if (a.numArguments < 2) return var();
+	m->sendToClient(a.arguments[0].toString(), a.arguments[1].toString());
+	return var();
+}
+
+var TCPServerModule::sendBytesToFromScript(const var::NativeFunctionArgs& a)
+{
+	TCPServerModule* m = getObjectFromJS<TCPServerModule>(a);
+	if (a.numArguments < 2) return var();
+	Array<uint8> data;
+	for (int i = 1; i < a.numArguments; i++)
+	{
+		if (a.arguments[i].isArray())
+		{
+			Array<var>* aa = a.arguments[i].getArray();
+			for (auto& vaa : *aa) data.add((uint8)(int)vaa);
+		}
+		else if (a.arguments[i].isInt() || a.arguments[i].isDouble())
+		{
+			data.add((uint8)(int)a.arguments[i]);
+		}
+	}
+
+	m->sendBytesToClient(a.arguments[0].toString(), data);
+	return var();
+}
+
+var TCPServerModule::getClientsFromScript(const var::NativeFunctionArgs& a)
+{
+	TCPServerModule* m = getObjectFromJS<TCPServerModule>(a);
+	var result = var(Array<var>()); //initialize force array
+	for (auto& id : m->getClientIds()) result.append(id);
+	return result;
+}
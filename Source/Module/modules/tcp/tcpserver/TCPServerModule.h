@@ -25,6 +25,35 @@ public:
 
 	TCPServerConnectionManager connectionManager;
 	IntParameter* numClients;
+	StringParameter* lastClient;
+
+	enum SendTarget { ALL_CLIENTS, LAST_CLIENT };
+	EnumParameter* sendTarget;
+
+	//each client keeps its own framing state, so messages from different clients never get mixed
+	struct ClientStream :
+		public ReferenceCountedObject
+	{
+		typedef ReferenceCountedObjectPtr<ClientStream> Ptr;
+
+		ClientStream(StreamingSocket* s, const String& id) : socket(s), id(id) {}
+		StreamingSocket* socket; //set to nullptr under writeLock once the connection is removed
+		String id; //ip:port of the client
+		StreamBuffer buffer;
+		CriticalSection writeLock; //writes are made outside clientsLock, so a client slow to read doesn't block the others
+	};
+
+	CriticalSection clientsLock;
+	ReferenceCountedArray<ClientStream> clients;
+	HashMap<int, ClientStream*> clientsByHandle;
+	HeapBlock<uint8> readBuffer;
+	static const int readBufferSize = 65536;
+
+	ThreadLocalValue<String> targetClient; //overrides the send target while sending to a specific client from this thread
+
+#if JUCE_LINUX
+	int epollHandle;
+#endif
 
 
 	virtual void setupReceiver() override;
@@ -37,7 +66,18 @@ public:
 	virtual void sendMessageInternal(const String& message) override;
 	virtual void sendBytesInternal(Array<uint8> data) override;
 
-	virtual Array<uint8> readBytes() override;
+	void sendToClient(const String& clientId, const String& message);
+	void sendBytesToClient(const String& clientId, Array<uint8> data);
+	void writeToClients(const void* data, int numBytes);
+
+	StringArray getClientIds();
+	static String getClientId(StreamingSocket* s);
+
+	virtual void setInputSource(const String& source) override;
+
+	virtual void run() override;
+	void waitForReadyClients(Array<int>& readyHandles, int timeoutMs);
+	void readClient(ClientStream* c, Array<StreamingSocket*>& connectionsToRemove);
 
 	virtual void clearInternal() override;
 
@@ -47,6 +87,14 @@ public:
 
 	ModuleUI* getModuleUI() override;
 
+	const Identifier sendToId = "sendTo";
+	const Identifier sendBytesToId = "sendBytesTo";
+	const Identifier getClientsId = "getClients";
+
+	static var sendToFromScript(const var::NativeFunctionArgs& a);
+	static var sendBytesToFromScript(const var::NativeFunctionArgs& a);
+	static var getClientsFromScript(const var::NativeFunctionArgs& a);
+
 	static TCPServerModule* create() { return new TCPServerModule(); }
 	virtual String getDefaultTypeString() const override { return "TCP Server"; }
 };
\ No newline at end of file
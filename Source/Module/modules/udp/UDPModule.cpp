@@ -10,10 +10,36 @@
 
 #include "UDPModule.h"
 
+#if JUCE_WINDOWS
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <errno.h>
+#endif
+
 UDPModule::UDPModule(const String & name, bool canHaveInput, bool canHaveOutput, int defaultLocalPort, int defaultRemotePort) :
-	NetworkStreamingModule(name, canHaveInput,canHaveOutput,defaultLocalPort,defaultRemotePort)
+	NetworkStreamingModule(name, canHaveInput,canHaveOutput,defaultLocalPort,defaultRemotePort),
+	lastSenderIP(nullptr),
+	lastSenderPort(nullptr)
 {
 	if (senderIsConnected != nullptr) senderIsConnected->hideInOutliner = true; //no need because UDP doesn't check remote client existance
+	receiveFrequency->hideInEditor = true; //the receiver waits for incoming datagrams instead of polling
+
+	if (receiveCC != nullptr)
+	{
+		lastSenderIP = receiveCC->addStringParameter("Last Sender IP", "IP of the host that sent the last received datagram", "");
+		lastSenderPort = receiveCC->addIntParameter("Last Sender Port", "Port from which the last received datagram was sent", 0, 0, 65535);
+		lastSenderIP->setControllableFeedbackOnly(true);
+		lastSenderPort->setControllableFeedbackOnly(true);
+		lastSenderIP->isSavable = false;
+		lastSenderPort->isSavable = false;
+	}
+
+	datagramBuffer.allocate(maxDatagramSize * maxDatagramsPerRead, false);
+
 	if(!Engine::mainEngine->isLoadingFile) setupReceiver();
 	setupSender();
 }
@@ -41,6 +67,22 @@ void UDPModule::setupReceiver()
 	{
 		receiver->setEnablePortReuse(true);
 
+		int bufferSize = receiveBufferSize;
+		if (setsockopt(receiver->getRawSocketHandle(), SOL_SOCKET, SO_RCVBUF, (const char *)&bufferSize, sizeof(bufferSize)) != 0)
+		{
+			NLOGWARNING(niceName, "Could not enlarge the UDP receive buffer, bursts of data may be dropped");
+		}
+		else
+		{
+			//the system silently caps the size (net.core.rmem_max on Linux, which also reports twice the usable size)
+			int actualSize = 0;
+			socklen_t optionLength = sizeof(actualSize);
+			if (getsockopt(receiver->getRawSocketHandle(), SOL_SOCKET, SO_RCVBUF, (char *)&actualSize, &optionLength) == 0 && actualSize < bufferSize)
+			{
+				NLOGWARNING(niceName, "UDP receive buffer is only " << (actualSize / 1024) << " kB instead of " << (bufferSize / 1024) << " kB, bursts of data may be dropped. The system limit may need to be raised");
+			}
+		}
+
 		NLOG(niceName, "UDP Receiver bound to port " << localPort->intValue());
 		localPort->clearWarning();
 		startThread();
@@ -94,27 +136,163 @@ void UDPModule::sendBytesInternal(Array<uint8> data)
 	sender->write(targetHost, remotePort->intValue(), data.getRawDataPointer(), data.size());
 }
 
-Array<uint8> UDPModule::readBytes()
+void UDPModule::receiveDatagrams()
 {
-	Array<uint8> result;
-	uint8 data[255];
-	while (true)
+#if JUCE_LINUX
+	//drain everything that is queued, up to maxDatagramsPerRead datagrams per syscall
+	mmsghdr messages[maxDatagramsPerRead];
+	iovec buffers[maxDatagramsPerRead];
+	sockaddr_in addresses[maxDatagramsPerRead];
+
+	while (!threadShouldExit())
+	{
+		for (int i = 0; i < maxDatagramsPerRead; i++)
+		{
+			buffers[i].iov_base = datagramBuffer + i * maxDatagramSize;
+			buffers[i].iov_len = maxDatagramSize;
+			zerostruct(messages[i]);
+			messages[i].msg_hdr.msg_iov = &buffers[i];
+			messages[i].msg_hdr.msg_iovlen = 1;
+			messages[i].msg_hdr.msg_name = &addresses[i];
+			messages[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+		}
+
+		int numMessages = recvmmsg(receiver->getRawSocketHandle(), messages, maxDatagramsPerRead, MSG_DONTWAIT, nullptr);
+		if (numMessages <= 0)
+		{
+			if (numMessages < 0 && errno != EAGAIN && errno != EWOULDBLOCK) NLOGERROR(niceName, "Error receiving UDP data");
+			return;
+		}
+
+		for (int i = 0; i < numMessages; i++)
+		{
+			char ip[INET_ADDRSTRLEN] = { 0 };
+			inet_ntop(AF_INET, &addresses[i].sin_addr, ip, sizeof(ip));
+			handleDatagram(datagramBuffer + i * maxDatagramSize, (int)messages[i].msg_len, String(ip), ntohs(addresses[i].sin_port));
+		}
+
+		if (numMessages < maxDatagramsPerRead) return;
+	}
+#else
+	while (!threadShouldExit())
 	{
-		int numBytes = receiver->read(data, 255, false);
+		String senderIP;
+		int senderPort = 0;
+		int numBytes = receiver->read(datagramBuffer, maxDatagramSize, false, senderIP, senderPort);
 
 		if (numBytes == -1)
 		{
-			LOGERROR("Error receiving UDP data");
-			return result;
+			NLOGERROR(niceName, "Error receiving UDP data");
+			return;
+		}
+
+		if (numBytes == 0) return;
+
+		handleDatagram(datagramBuffer, numBytes, senderIP, senderPort);
+	}
+#endif
+}
+
+void UDPModule::handleDatagram(const uint8 * data, int numBytes, const String & senderIP, int senderPort)
+{
+	if (numBytes <= 0) return;
+	Array<uint8> datagram(data, numBytes);
+	postInput([this, datagram, senderIP, senderPort]() { processDatagram(datagram, senderIP, senderPort); });
+}
+
+void UDPModule::processDatagram(const Array<uint8> &datagram, const String & senderIP, int senderPort)
+{
+	if (lastSenderIP != nullptr)
+	{
+		lastSenderIP->setValue(senderIP);
+		lastSenderPort->setValue(senderPort);
+	}
+
+	if (scriptManager->items.size() > 0)
+	{
+		Array<var> params;
+		var bytes = var(Array<var>()); //initialize force array
+		for (auto &b : datagram) bytes.append(b);
+		params.add(bytes);
+		params.add(senderIP);
+		params.add(senderPort);
+		scriptManager->callFunctionOnAllItems(datagramEventId, params);
+	}
+
+	//a datagram always holds whole messages, nothing is carried over to the next one
+	const uint8 * data = datagram.getRawDataPointer();
+	const int numBytes = datagram.size();
+
+	StreamingType m = streamingType->getValueDataAsEnum<StreamingType>();
+	switch (m)
+	{
+	case LINES:
+	{
+		if (!CharPointer_UTF8::isValidString((const char *)data, numBytes)) break;
+		StringArray sa;
+		sa.addTokens(String::fromUTF8((const char *)data, numBytes), "\r\n", "\"");
+		sa.removeEmptyStrings();
+		for (auto &line : sa) processDataLine(line);
+	}
+	break;
+
+	case RAW:
+		processDataBytes(datagram);
+		break;
+
+	case DATA255:
+	{
+		const uint8 * end = data + numBytes;
+		while (data < end)
+		{
+			const uint8 * delimiter = (const uint8 *)memchr(data, 255, (size_t)(end - data));
+			if (delimiter == nullptr) delimiter = end;
+			if (delimiter > data) processDataBytes(Array<uint8>(data, (int)(delimiter - data)));
+			data = delimiter + 1;
+		}
+	}
+	break;
+
+	case COBS:
+	{
+		auto onFrame = [this](const uint8 * frame, size_t size) { processDataBytes(Array<uint8>(frame, (int)size)); };
+		cobsDecoder.process(data, (size_t)numBytes, onFrame);
+		cobsDecoder.flush(onFrame);
+	}
+	break;
+	}
+}
+
+void UDPModule::run()
+{
+	if (Engine::mainEngine != nullptr && Engine::mainEngine->isClearing) return;
+
+	while (!threadShouldExit())
+	{
+		if (receiver == nullptr || receiver->getBoundPort() == -1) break;
+
+		//blocks until some data is there, the timeout only bounds the exit delay
+		int ready = receiver->waitUntilReady(true, 300);
+		if (ready < 0)
+		{
+			//socket error, waitUntilReady returns straight away : don't spin until the receiver is closed or recovers
+			wait(100);
+			continue;
 		}
 
-		if (numBytes == 0) break;
+		if (ready == 0) continue;
 
-		result.addArray((const uint8 *)data, numBytes);
+		try
+		{
+			receiveDatagrams();
+		}
+		catch (...)
+		{
+			DBG("### UDP receive thread problem ");
+		}
 	}
-	
-	return result;
 
+	DBG("Exit thread");
 }
 
 void UDPModule::clearInternal()
@@ -22,6 +22,18 @@ public:
 	std::unique_ptr<DatagramSocket> receiver;
 	std::unique_ptr<DatagramSocket> sender;
 
+	StringParameter * lastSenderIP;
+	IntParameter * lastSenderPort;
+
+	//each datagram is handled as a whole, bursts are drained with as few syscalls as possible
+	static const int maxDatagramSize = 65536;
+	static const int maxDatagramsPerRead = 16;
+	static const int receiveBufferSize = 4 * 1024 * 1024; //kernel side buffer, absorbs bursts while the thread is busy
+	HeapBlock<uint8> datagramBuffer;
+	COBSFrameDecoder cobsDecoder;
+
+	const Identifier datagramEventId = "datagramReceived";
+
 	virtual void setupReceiver() override;
 	virtual void setupSender() override;
 
@@ -31,10 +43,14 @@ public:
 	virtual void sendMessageInternal(const String &message) override;
 	virtual void sendBytesInternal(Array<uint8> data) override;
 
-	virtual Array<uint8> readBytes() override;
+	void receiveDatagrams();
+	void handleDatagram(const uint8 * data, int numBytes, const String &senderIP, int senderPort);
+	void processDatagram(const Array<uint8> &datagram, const String &senderIP, int senderPort);
 
 	virtual void clearInternal() override;
 
+	virtual void run() override;
+
 	static UDPModule * create() { return new UDPModule(); } 
 	virtual String getDefaultTypeString() const override { return "UDP"; }
 };
\ No newline at end of file